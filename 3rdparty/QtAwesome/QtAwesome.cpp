@@ -10,10 +10,12 @@
 #include "QtAwesome.h"
 #include "QtAwesomeAnim.h"
 
+#include <QCoreApplication>
 #include <QDebug>
 #include <QFile>
 #include <QFontDatabase>
 #include <QFontMetrics>
+#include <QPixmapCache>
 
 QtAwesomeIconPainter::~QtAwesomeIconPainter()
 {
@@ -153,6 +155,7 @@ public:
         : awesomeRef_(awesome)
         , iconPainterRef_(painter)
         , options_(options)
+        , cacheKeyPrefix_(cacheKeyPrefix(painter, options))
     {
     }
 
@@ -172,20 +175,72 @@ public:
 
     virtual QPixmap pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state)
     {
-        QPixmap pm(size);
+        // Qt asks for a pixmap on every repaint of a button, so keep the
+        // rendered glyphs in the global pixmap cache. The size requested is
+        // already in device pixels, so it accounts for the pixel ratio.
+        QString key;
+        QPixmap pm;
+
+        if( !cacheKeyPrefix_.isEmpty() ) {
+            key = QString("%1:%2x%3:%4:%5")
+                .arg(cacheKeyPrefix_)
+                .arg(size.width())
+                .arg(size.height())
+                .arg(static_cast<int>(mode))
+                .arg(static_cast<int>(state));
+
+            if( QPixmapCache::find(key, &pm) ) {
+                return pm;
+            }
+        }
+
+        pm = QPixmap(size);
         pm.fill( Qt::transparent ); // we need transparency
         {
             QPainter p(&pm);
             paint(&p, QRect(QPoint(0,0),size), mode, state);
         }
+
+        if( !key.isEmpty() ) {
+            QPixmapCache::insert(key, pm);
+        }
+
         return pm;
     }
 
 private:
 
+    /// Builds the part of the pixmap cache key shared by every pixmap of this icon.
+    /// Returns an empty string for animated icons, which must not be cached.
+    static QString cacheKeyPrefix( QtAwesomeIconPainter* painter, const QVariantMap& options )
+    {
+        QVariant anim = options.value("anim");
+
+        if( anim.isValid() && anim.value<QtAwesomeAnimation*>() ) {
+            return QString();
+        }
+
+        QString prefix = QString("qtawesome:%1").arg(reinterpret_cast<quintptr>(painter));
+
+        for( QVariantMap::const_iterator it = options.constBegin(); it != options.constEnd(); ++it ) {
+            QString value;
+
+            if( it.value().type() == QVariant::Color ) {
+                value = it.value().value<QColor>().name(QColor::HexArgb);
+            } else {
+                value = it.value().toString();
+            }
+
+            prefix += QString(";%1=%2").arg(it.key(), value);
+        }
+
+        return prefix;
+    }
+
     QtAwesome* awesomeRef_;                  ///< a reference to the QtAwesome instance
     QtAwesomeIconPainter* iconPainterRef_;   ///< a reference to the icon painter
     QVariantMap options_;                    ///< the options for this icon painter
+    QString cacheKeyPrefix_;                 ///< the pixmap cache key for these options
 };
 
 QtAwesomeIconPainterIconEngine::~QtAwesomeIconPainterIconEngine(){
@@ -2353,6 +2408,21 @@ static const FANameIcon faCommonIconArray[] = {
 };
 
 
+/// Returns the instance shared by the whole application, with font-awesome
+/// already initialized. Using it avoids loading the fonts more than once.
+/// It is owned by the application object, which must exist on the first call.
+QtAwesome* QtAwesome::instance()
+{
+    static QtAwesome* sharedInstance = nullptr;
+
+    if( nullptr == sharedInstance ) {
+        sharedInstance = new QtAwesome(QCoreApplication::instance());
+        sharedInstance->initFontAwesome();
+    }
+
+    return sharedInstance;
+}
+
 /// a specialized init function so font-awesome is loaded and initialized
 /// this method return true on success, it will return false if the fnot cannot be initialized
 /// To initialize QtAwesome with font-awesome you need to call this method
@@ -2162,6 +2162,8 @@ public:
     explicit QtAwesome(QObject *parent = nullptr);
     virtual ~QtAwesome();
 
+    static QtAwesome* instance();
+
     bool initFontAwesome();
 
     const QHash<QString, int> namedCodePoints(style::styles st) const;
@@ -26,6 +26,7 @@ HEADERS += \
     $$PWD/src/registry.h \
     $$PWD/src/render.h \
     $$PWD/src/scanners.h \
+    $$PWD/src/simd.h \
     $$PWD/src/syntax_extension.h \
     $$PWD/src/utf8.h \
     $$PWD/extensions/autolink.h \
@@ -14,10 +14,18 @@
 cmark_node_type CMARK_NODE_TABLE, CMARK_NODE_TABLE_ROW,
     CMARK_NODE_TABLE_CELL;
 
+typedef struct {
+  cmark_strbuf buf;
+  int start_offset, end_offset, internal_offset;
+} node_cell;
+
+// Cells are kept in a contiguous array that grows geometrically, so appending
+// a cell is O(1) and a row costs a handful of allocations however wide it is.
 typedef struct {
   uint16_t n_columns;
   int paragraph_offset;
-  cmark_llist *cells;
+  int cells_size;
+  node_cell *cells;
 } table_row;
 
 typedef struct {
@@ -29,27 +37,38 @@ typedef struct {
   bool is_header;
 } node_table_row;
 
-typedef struct {
-  cmark_strbuf *buf;
-  int start_offset, end_offset, internal_offset;
-} node_cell;
+static void free_row_cells(table_row *row) {
+  int i;
+
+  for (i = 0; i < row->n_columns; ++i)
+    cmark_strbuf_free(&row->cells[i].buf);
 
-static void free_table_cell(cmark_mem *mem, void *data) {
-  node_cell *cell = (node_cell *)data;
-  cmark_strbuf_free((cmark_strbuf *)cell->buf);
-  mem->free(cell->buf);
-  mem->free(cell);
+  row->n_columns = 0;
 }
 
 static void free_table_row(cmark_mem *mem, table_row *row) {
   if (!row)
     return;
 
-  cmark_llist_free_full(mem, row->cells, (cmark_free_func)free_table_cell);
-
+  free_row_cells(row);
+  mem->free(row->cells);
   mem->free(row);
 }
 
+static node_cell *append_row_cell(cmark_mem *mem, table_row *row) {
+  node_cell *cell;
+
+  if (row->n_columns == row->cells_size) {
+    row->cells_size = row->cells_size ? row->cells_size * 2 : 8;
+    row->cells = (node_cell *)mem->realloc(
+        row->cells, (size_t)row->cells_size * sizeof(node_cell));
+  }
+
+  cell = &row->cells[row->n_columns++];
+  memset(cell, 0, sizeof(*cell));
+  return cell;
+}
+
 static void free_node_table(cmark_mem *mem, void *ptr) {
   node_table *t = (node_table *)ptr;
   mem->free(t->alignments);
@@ -90,9 +109,9 @@ static int set_table_alignments(cmark_node *node, uint8_t *alignments) {
   return 1;
 }
 
-static cmark_strbuf *unescape_pipes(cmark_mem *mem, unsigned char *string, bufsize_t len)
+static void unescape_pipes(cmark_mem *mem, cmark_strbuf *res,
+                           unsigned char *string, bufsize_t len)
 {
-  cmark_strbuf *res = (cmark_strbuf *)mem->calloc(1, sizeof(cmark_strbuf));
   bufsize_t r, w;
 
   cmark_strbuf_init(mem, res, len + 1);
@@ -107,13 +126,13 @@ static cmark_strbuf *unescape_pipes(cmark_mem *mem, unsigned char *string, bufsi
   }
 
   cmark_strbuf_truncate(res, w);
-
-  return res;
 }
 
-static table_row *row_from_string(cmark_syntax_extension *self,
-                                  cmark_parser *parser, unsigned char *string,
-                                  int len) {
+// Scans a row into `row`. If `mem` is NULL the cells are only counted and no
+// memory is allocated, which is all callers that merely need to know whether
+// a line is a row of a given width require.
+static bool scan_row(cmark_mem *mem, unsigned char *string, int len,
+                     table_row *row) {
   // Parses a single table row. It has the following form:
   // `delim? table_cell (delim table_cell)* delim? newline`
   // Note that cells are allowed to be empty.
@@ -125,16 +144,11 @@ static table_row *row_from_string(cmark_syntax_extension *self,
   // > recommended for clarity of reading, and if there’s otherwise parsing
   // > ambiguity.
 
-  table_row *row = NULL;
   bufsize_t cell_matched = 1, pipe_matched = 1, offset;
   int expect_more_cells = 1;
   int row_end_offset = 0;
   int int_overflow_abort = 0;
 
-  row = (table_row *)parser->mem->calloc(1, sizeof(table_row));
-  row->n_columns = 0;
-  row->cells = NULL;
-
   // Scan past the (optional) leading pipe.
   offset = scan_table_cell_end(string, len, 0);
 
@@ -148,19 +162,6 @@ static table_row *row_from_string(cmark_syntax_extension *self,
       // We are guaranteed to have a cell, since (1) either we found some
       // content and cell_matched, or (2) we found an empty cell followed by a
       // pipe.
-      cmark_strbuf *cell_buf = unescape_pipes(parser->mem, string + offset,
-          cell_matched);
-      cmark_strbuf_trim(cell_buf);
-
-      node_cell *cell = (node_cell *)parser->mem->calloc(1, sizeof(*cell));
-      cell->buf = cell_buf;
-      cell->start_offset = offset;
-      cell->end_offset = offset + cell_matched - 1;
-
-      while (cell->start_offset > 0 && string[cell->start_offset - 1] != '|') {
-        --cell->start_offset;
-        ++cell->internal_offset;
-      }
 
       // make sure we never wrap row->n_columns
       // offset will != len and our exit will clean up as intended
@@ -168,8 +169,23 @@ static table_row *row_from_string(cmark_syntax_extension *self,
           int_overflow_abort = 1;
           break;
       }
-      row->n_columns += 1;
-      row->cells = cmark_llist_append(parser->mem, row->cells, cell);
+
+      if (!mem) {
+        row->n_columns += 1;
+      } else {
+        node_cell *cell = append_row_cell(mem, row);
+
+        unescape_pipes(mem, &cell->buf, string + offset, cell_matched);
+        cmark_strbuf_trim(&cell->buf);
+
+        cell->start_offset = offset;
+        cell->end_offset = offset + cell_matched - 1;
+
+        while (cell->start_offset > 0 && string[cell->start_offset - 1] != '|') {
+          --cell->start_offset;
+          ++cell->internal_offset;
+        }
+      }
     }
 
     offset += cell_matched + pipe_matched;
@@ -187,8 +203,8 @@ static table_row *row_from_string(cmark_syntax_extension *self,
       if (row_end_offset && offset != len) {
         row->paragraph_offset = offset;
 
-        cmark_llist_free_full(parser->mem, row->cells, (cmark_free_func)free_table_cell);
-        row->cells = NULL;
+        if (mem)
+          free_row_cells(row);
         row->n_columns = 0;
 
         // Scan past the (optional) leading pipe.
@@ -201,7 +217,15 @@ static table_row *row_from_string(cmark_syntax_extension *self,
     }
   }
 
-  if (offset != len || row->n_columns == 0 || int_overflow_abort) {
+  return offset == len && row->n_columns != 0 && !int_overflow_abort;
+}
+
+static table_row *row_from_string(cmark_syntax_extension *self,
+                                  cmark_parser *parser, unsigned char *string,
+                                  int len) {
+  table_row *row = (table_row *)parser->mem->calloc(1, sizeof(table_row));
+
+  if (!scan_row(parser->mem, string, len, row)) {
     free_table_row(parser->mem, row);
     row = NULL;
   }
@@ -209,20 +233,31 @@ static table_row *row_from_string(cmark_syntax_extension *self,
   return row;
 }
 
+// Returns the number of cells in the row, or 0 if the string is not a row.
+static int row_cell_count(unsigned char *string, int len) {
+  table_row row;
+
+  memset(&row, 0, sizeof(row));
+
+  if (!scan_row(NULL, string, len, &row))
+    return 0;
+
+  return row.n_columns;
+}
+
 static void try_inserting_table_header_paragraph(cmark_parser *parser,
                                                  cmark_node *parent_container,
                                                  unsigned char *parent_string,
                                                  int paragraph_offset) {
   cmark_node *paragraph;
-  cmark_strbuf *paragraph_content;
+  cmark_strbuf paragraph_content;
 
   paragraph = cmark_node_new_with_mem(CMARK_NODE_PARAGRAPH, parser->mem);
 
-  paragraph_content = unescape_pipes(parser->mem, parent_string, paragraph_offset);
-  cmark_strbuf_trim(paragraph_content);
-  cmark_node_set_string_content(paragraph, (char *) paragraph_content->ptr);
-  cmark_strbuf_free(paragraph_content);
-  parser->mem->free(paragraph_content);
+  unescape_pipes(parser->mem, &paragraph_content, parent_string, paragraph_offset);
+  cmark_strbuf_trim(&paragraph_content);
+  cmark_node_set_string_content(paragraph, (char *) paragraph_content.ptr);
+  cmark_strbuf_free(&paragraph_content);
 
   if (!cmark_node_insert_before(parent_container, paragraph)) {
     parser->mem->free(paragraph);
@@ -238,6 +273,7 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
   table_row *marker_row = NULL;
   node_table_row *ntr;
   const char *parent_string;
+  int parent_len;
   uint16_t i;
 
   if (!scan_table_start(input, len, cmark_parser_get_first_nonspace(parser))) {
@@ -255,35 +291,28 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
   
   assert(marker_row);
 
-  cmark_arena_push();
-
-  // Check for a matching header row. We call `row_from_string` with the entire
-  // (potentially long) parent container as input, but this should be safe since
-  // `row_from_string` bails out early if it does not find a row.
+  // Check for a matching header row. We scan the entire (potentially long)
+  // parent container as input, but this should be safe since the scan bails
+  // out early if it does not find a row. Counting the cells first allocates
+  // nothing, so a paragraph that turns out not to be a header row costs no
+  // memory and the delimiter row does not need to be parsed again.
   parent_string = cmark_node_get_string_content(parent_container);
+  parent_len = (int)strlen(parent_string);
+  if (row_cell_count((unsigned char *)parent_string, parent_len) !=
+      marker_row->n_columns) {
+    free_table_row(parser->mem, marker_row);
+    return parent_container;
+  }
+
   header_row = row_from_string(self, parser, (unsigned char *)parent_string,
-                               (int)strlen(parent_string));
+                               parent_len);
+  // row_from_string can return NULL, add additional check to ensure n_columns match
   if (!header_row || header_row->n_columns != marker_row->n_columns) {
     free_table_row(parser->mem, marker_row);
     free_table_row(parser->mem, header_row);
-    cmark_arena_pop();
     return parent_container;
   }
 
-  if (cmark_arena_pop()) {
-    marker_row = row_from_string(
-        self, parser, input + cmark_parser_get_first_nonspace(parser),
-        len - cmark_parser_get_first_nonspace(parser));
-    header_row = row_from_string(self, parser, (unsigned char *)parent_string,
-                                 (int)strlen(parent_string));
-    // row_from_string can return NULL, add additional check to ensure n_columns match
-    if (!marker_row || !header_row || header_row->n_columns != marker_row->n_columns) {
-        free_table_row(parser->mem, marker_row);
-        free_table_row(parser->mem, header_row);
-        return parent_container;
-    }
-  }
-
   if (!cmark_node_set_type(parent_container, CMARK_NODE_TABLE)) {
     free_table_row(parser->mem, header_row);
     free_table_row(parser->mem, marker_row);
@@ -303,10 +332,9 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
   // since we populate the alignments array based on marker_row->cells
   uint8_t *alignments =
       (uint8_t *)parser->mem->calloc(marker_row->n_columns, sizeof(uint8_t));
-  cmark_llist *it = marker_row->cells;
-  for (i = 0; it; it = it->next, ++i) {
-    node_cell *node = (node_cell *)it->data;
-    bool left = node->buf->ptr[0] == ':', right = node->buf->ptr[node->buf->size - 1] == ':';
+  for (i = 0; i < marker_row->n_columns; ++i) {
+    node_cell *node = &marker_row->cells[i];
+    bool left = node->buf.ptr[0] == ':', right = node->buf.ptr[node->buf.size - 1] == ':';
 
     if (left && right)
       alignments[i] = 'c';
@@ -321,23 +349,21 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
       cmark_parser_add_child(parser, parent_container, CMARK_NODE_TABLE_ROW,
                              parent_container->start_column);
   cmark_node_set_syntax_extension(table_header, self);
-  table_header->end_column = parent_container->start_column + (int)strlen(parent_string) - 2;
+  table_header->end_column = parent_container->start_column + parent_len - 2;
   table_header->start_line = table_header->end_line = parent_container->start_line;
 
   table_header->as.opaque = ntr = (node_table_row *)parser->mem->calloc(1, sizeof(node_table_row));
   ntr->is_header = true;
 
   {
-    cmark_llist *tmp;
-
-    for (tmp = header_row->cells; tmp; tmp = tmp->next) {
-      node_cell *cell = (node_cell *) tmp->data;
+    for (i = 0; i < header_row->n_columns; ++i) {
+      node_cell *cell = &header_row->cells[i];
       cmark_node *header_cell = cmark_parser_add_child(parser, table_header,
           CMARK_NODE_TABLE_CELL, parent_container->start_column + cell->start_offset);
       header_cell->start_line = header_cell->end_line = parent_container->start_line;
       header_cell->internal_offset = cell->internal_offset;
       header_cell->end_column = parent_container->start_column + cell->end_offset;
-      cmark_node_set_string_content(header_cell, (char *) cell->buf->ptr);
+      cmark_node_set_string_content(header_cell, (char *) cell->buf.ptr);
       cmark_node_set_syntax_extension(header_cell, self);
     }
   }
@@ -378,16 +404,15 @@ static cmark_node *try_opening_table_row(cmark_syntax_extension *self,
   }
 
   {
-    cmark_llist *tmp;
     int i, table_columns = get_n_table_columns(parent_container);
 
-    for (tmp = row->cells, i = 0; tmp && i < table_columns; tmp = tmp->next, ++i) {
-      node_cell *cell = (node_cell *) tmp->data;
+    for (i = 0; i < row->n_columns && i < table_columns; ++i) {
+      node_cell *cell = &row->cells[i];
       cmark_node *node = cmark_parser_add_child(parser, table_row_block,
           CMARK_NODE_TABLE_CELL, parent_container->start_column + cell->start_offset);
       node->internal_offset = cell->internal_offset;
       node->end_column = parent_container->start_column + cell->end_offset;
-      cmark_node_set_string_content(node, (char *) cell->buf->ptr);
+      cmark_node_set_string_content(node, (char *) cell->buf.ptr);
       cmark_node_set_syntax_extension(node, self);
     }
 
@@ -427,14 +452,9 @@ static int matches(cmark_syntax_extension *self, cmark_parser *parser,
   int res = 0;
 
   if (cmark_node_get_type(parent_container) == CMARK_NODE_TABLE) {
-    cmark_arena_push();
-    table_row *new_row = row_from_string(
-        self, parser, input + cmark_parser_get_first_nonspace(parser),
-        len - cmark_parser_get_first_nonspace(parser));
-    if (new_row && new_row->n_columns)
+    if (row_cell_count(input + cmark_parser_get_first_nonspace(parser),
+                       len - cmark_parser_get_first_nonspace(parser)))
       res = 1;
-    free_table_row(parser->mem, new_row);
-    cmark_arena_pop();
   }
 
   return res;
@@ -666,6 +686,9 @@ static void html_table_add_align(cmark_strbuf* html, const char* align, int opti
 struct html_table_state {
   unsigned need_closing_table_body : 1;
   unsigned in_table_header : 1;
+  // Index of the next cell in the current row, so that looking up a cell's
+  // alignment does not walk its preceding siblings.
+  unsigned cell_index : 30;
 };
 
 static void html_render(cmark_syntax_extension *extension,
@@ -673,7 +696,6 @@ static void html_render(cmark_syntax_extension *extension,
                         cmark_event_type ev_type, int options) {
   bool entering = (ev_type == CMARK_EVENT_ENTER);
   cmark_strbuf *html = renderer->html;
-  cmark_node *n;
 
   // XXX: we just monopolise renderer->opaque.
   struct html_table_state *table_state =
@@ -712,6 +734,7 @@ static void html_render(cmark_syntax_extension *extension,
       cmark_strbuf_puts(html, "<tr");
       cmark_html_render_sourcepos(node, html, options);
       cmark_strbuf_putc(html, '>');
+      table_state->cell_index = 0;
     } else {
       cmark_html_render_cr(html);
       cmark_strbuf_puts(html, "</tr>");
@@ -731,12 +754,7 @@ static void html_render(cmark_syntax_extension *extension,
         cmark_strbuf_puts(html, "<td");
       }
 
-      int i = 0;
-      for (n = node->parent->first_child; n; n = n->next, ++i)
-        if (n == node)
-          break;
-
-      switch (alignments[i]) {
+      switch (alignments[table_state->cell_index++]) {
       case 'l': html_table_add_align(html, "left", options); break;
       case 'c': html_table_add_align(html, "center", options); break;
       case 'r': html_table_add_align(html, "right", options); break;
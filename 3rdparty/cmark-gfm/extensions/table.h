@@ -3,10 +3,17 @@
 
 #include "cmark-gfm-core-extensions.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 extern cmark_node_type CMARK_NODE_TABLE, CMARK_NODE_TABLE_ROW,
     CMARK_NODE_TABLE_CELL;
 
 cmark_syntax_extension *create_table_extension(void);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
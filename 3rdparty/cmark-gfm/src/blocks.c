@@ -18,6 +18,7 @@
 #include "references.h"
 #include "utf8.h"
 #include "scanners.h"
+#include "simd.h"
 #include "inlines.h"
 #include "houdini.h"
 #include "buffer.h"
@@ -707,7 +708,7 @@ static void S_parser_feed(cmark_parser *parser, const unsigned char *buffer,
     const unsigned char *eol;
     bufsize_t chunk_len;
     bool process = false;
-    for (eol = buffer; eol < end; ++eol) {
+    for (eol = cmark_simd_find_line_end(buffer, end); eol < end; ++eol) {
       if (S_is_line_end_char(*eol)) {
         process = true;
         break;
@@ -822,12 +823,21 @@ static void S_find_first_nonspace(cmark_parser *parser, cmark_chunk *input) {
     parser->first_nonspace_column = parser->column;
     while ((c = peek_at(input, parser->first_nonspace))) {
       if (c == ' ') {
-        parser->first_nonspace += 1;
-        parser->first_nonspace_column += 1;
-        chars_to_tab = chars_to_tab - 1;
-        if (chars_to_tab == 0) {
-          chars_to_tab = TAB_STOP;
-        }
+        // Skip the whole run of spaces at once; each one advances the
+        // column by one and brings the next tab stop one closer.
+        const unsigned char *run = input->data + parser->first_nonspace;
+        const unsigned char *end = input->data + input->len;
+        const unsigned char *p = cmark_simd_skip_char(run, end, ' ');
+        bufsize_t spaces;
+
+        while (p < end && *p == ' ')
+          p++;
+
+        spaces = (bufsize_t)(p - run);
+        parser->first_nonspace += spaces;
+        parser->first_nonspace_column += spaces;
+        chars_to_tab =
+            TAB_STOP - ((TAB_STOP - chars_to_tab + spaces) % TAB_STOP);
       } else if (c == '\t') {
         parser->first_nonspace += 1;
         parser->first_nonspace_column += chars_to_tab;
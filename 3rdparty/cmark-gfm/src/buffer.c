@@ -54,9 +54,16 @@ void cmark_strbuf_grow(cmark_strbuf *buf, bufsize_t target_size) {
   new_size += 1;
   new_size = (new_size + 7) & ~7;
 
+  bool fresh = (buf->asize == 0);
+
   buf->ptr = (unsigned char *)buf->mem->realloc(buf->asize ? buf->ptr : NULL,
                                                 new_size);
   buf->asize = new_size;
+
+  /* A buffer grown ahead of being written to must still read back as an
+   * empty string. */
+  if (fresh)
+    buf->ptr[0] = '\0';
 }
 
 bufsize_t cmark_strbuf_len(const cmark_strbuf *buf) { return buf->size; }
@@ -622,6 +622,23 @@ char *cmark_render_html(cmark_node *root, int options, cmark_llist *extensions);
 CMARK_GFM_EXPORT
 char *cmark_render_html_with_mem(cmark_node *root, int options, cmark_llist *extensions, cmark_mem *mem);
 
+/** Callback that receives successive chunks of rendered output.  Returns
+ * 0 on success, or nonzero to stop rendering.
+ */
+typedef int (*cmark_write_func)(const char *data, size_t len, void *userdata);
+
+/** As for 'cmark_render_html_with_mem', but rather than returning the
+ * whole output, passes it to 'write' in chunks of roughly 'chunk_size'
+ * bytes as it is rendered, so that memory use does not grow with the
+ * size of the output.  Returns 0 on success, or the nonzero value
+ * returned by 'write' if it stopped rendering.
+ */
+CMARK_GFM_EXPORT
+int cmark_render_html_to_writer(cmark_node *root, int options,
+                                cmark_llist *extensions, cmark_mem *mem,
+                                cmark_write_func write, void *userdata,
+                                size_t chunk_size);
+
 /** Render a 'node' tree as a groff man page, without the header.
  * It is the caller's responsibility to free the returned buffer.
  */
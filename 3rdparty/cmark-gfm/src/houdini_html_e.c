@@ -3,6 +3,7 @@
 #include <string.h>
 
 #include "houdini.h"
+#include "simd.h"
 
 /**
  * According to the OWASP rules:
@@ -32,12 +33,27 @@ static const char HTML_ESCAPE_TABLE[] = {
 static const char *HTML_ESCAPES[] = {"",      "&quot;", "&amp;", "&#39;",
                                      "&#47;", "&lt;",   "&gt;"};
 
+static const bufsize_t HTML_ESCAPE_LENGTHS[] = {0, 6, 5, 5, 5, 4, 4};
+
 int houdini_escape_html0(cmark_strbuf *ob, const uint8_t *src, bufsize_t size,
                          int secure) {
   bufsize_t i = 0, org, esc = 0;
 
+  // Most text needs little or no escaping, so reserve room for all of it
+  // up front rather than growing the buffer once per clean run.
+  if (size > 0)
+    cmark_strbuf_grow(ob, ob->size + size);
+
   while (i < size) {
     org = i;
+
+    // Skip ahead over clean bytes.  Outside of secure mode only four
+    // characters need escaping, few enough to compare against directly.
+    if (!secure)
+      i = (bufsize_t)(cmark_simd_find_any4(src + i, src + size, '"', '&',
+                                           '<', '>') -
+                      src);
+
     while (i < size && (esc = HTML_ESCAPE_TABLE[src[i]]) == 0)
       i++;
 
@@ -52,7 +68,8 @@ int houdini_escape_html0(cmark_strbuf *ob, const uint8_t *src, bufsize_t size,
     if ((src[i] == '/' || src[i] == '\'') && !secure) {
       cmark_strbuf_putc(ob, src[i]);
     } else {
-      cmark_strbuf_puts(ob, HTML_ESCAPES[esc]);
+      cmark_strbuf_put(ob, (const unsigned char *)HTML_ESCAPES[esc],
+                       HTML_ESCAPE_LENGTHS[esc]);
     }
 
     i++;
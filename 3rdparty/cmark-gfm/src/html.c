@@ -449,16 +449,31 @@ static int S_render_node(cmark_html_renderer *renderer, cmark_node *node,
   return 1;
 }
 
-char *cmark_render_html(cmark_node *root, int options, cmark_llist *extensions) {
-  return cmark_render_html_with_mem(root, options, extensions, cmark_node_mem(root));
+// Passes all but the last byte of the buffer to the writer, keeping the
+// last byte since cmark_html_render_cr() looks back at it.
+static int S_flush(cmark_strbuf *html, cmark_write_func write, void *userdata) {
+  int err;
+
+  if (html->size <= 1)
+    return 0;
+
+  err = write((const char *)html->ptr, (size_t)(html->size - 1), userdata);
+  html->ptr[0] = html->ptr[html->size - 1];
+  cmark_strbuf_truncate(html, 1);
+  return err;
 }
 
-char *cmark_render_html_with_mem(cmark_node *root, int options, cmark_llist *extensions, cmark_mem *mem) {
-  char *result;
-  cmark_strbuf html = CMARK_BUF_INIT(mem);
+// Renders into html.  If write is not NULL, the rendered output is passed
+// to it whenever the buffer grows past chunk_size, so that the buffer
+// stays bounded in size.
+static int S_render_html(cmark_strbuf *html, cmark_node *root, int options,
+                         cmark_llist *extensions, cmark_mem *mem,
+                         cmark_write_func write, void *userdata,
+                         bufsize_t chunk_size) {
+  int err = 0;
   cmark_event_type ev_type;
   cmark_node *cur;
-  cmark_html_renderer renderer = {&html, NULL, NULL, 0, 0, NULL};
+  cmark_html_renderer renderer = {html, NULL, NULL, 0, 0, NULL};
   cmark_iter *iter = cmark_iter_new(root);
 
   for (; extensions; extensions = extensions->next)
@@ -471,16 +486,53 @@ char *cmark_render_html_with_mem(cmark_node *root, int options, cmark_llist *ext
   while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
     cur = cmark_iter_get_node(iter);
     S_render_node(&renderer, cur, ev_type, options);
+
+    if (write && html->size >= chunk_size) {
+      err = S_flush(html, write, userdata);
+      if (err)
+        break;
+    }
   }
 
-  if (renderer.footnote_ix) {
-    cmark_strbuf_puts(&html, "</ol>\n</section>\n");
+  if (!err && renderer.footnote_ix) {
+    cmark_strbuf_puts(html, "</ol>\n</section>\n");
   }
 
-  result = (char *)cmark_strbuf_detach(&html);
+  if (!err && write && html->size) {
+    err = write((const char *)html->ptr, (size_t)html->size, userdata);
+    cmark_strbuf_clear(html);
+  }
 
   cmark_llist_free(mem, renderer.filter_extensions);
 
   cmark_iter_free(iter);
-  return result;
+  return err;
+}
+
+char *cmark_render_html(cmark_node *root, int options, cmark_llist *extensions) {
+  return cmark_render_html_with_mem(root, options, extensions, cmark_node_mem(root));
+}
+
+char *cmark_render_html_with_mem(cmark_node *root, int options, cmark_llist *extensions, cmark_mem *mem) {
+  cmark_strbuf html = CMARK_BUF_INIT(mem);
+
+  S_render_html(&html, root, options, extensions, mem, NULL, NULL, 0);
+  return (char *)cmark_strbuf_detach(&html);
+}
+
+int cmark_render_html_to_writer(cmark_node *root, int options,
+                                cmark_llist *extensions, cmark_mem *mem,
+                                cmark_write_func write, void *userdata,
+                                size_t chunk_size) {
+  int err;
+  cmark_strbuf html = CMARK_BUF_INIT(mem);
+
+  if (chunk_size < 1 || chunk_size > (1 << 30))
+    chunk_size = 65536;
+
+  cmark_strbuf_grow(&html, (bufsize_t)chunk_size);
+  err = S_render_html(&html, root, options, extensions, mem, write, userdata,
+                      (bufsize_t)chunk_size);
+  cmark_strbuf_free(&html);
+  return err;
 }
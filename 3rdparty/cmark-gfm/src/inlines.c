@@ -11,6 +11,7 @@
 #include "houdini.h"
 #include "utf8.h"
 #include "scanners.h"
+#include "simd.h"
 #include "inlines.h"
 #include "syntax_extension.h"
 
@@ -1311,9 +1312,47 @@ static char SMART_PUNCT_CHARS[] = {
       0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 };
 
+// Vectorized counterparts of SPECIAL_CHARS, without and with the smart
+// punctuation characters.  Rebuilt whenever SPECIAL_CHARS changes.
+static cmark_simd_set SPECIAL_SET;
+static cmark_simd_set SPECIAL_SMART_SET;
+static bool SPECIAL_SETS_STALE = true;
+
+static void build_special_sets(void) {
+  int c;
+
+  cmark_simd_set_clear(&SPECIAL_SET);
+  cmark_simd_set_clear(&SPECIAL_SMART_SET);
+
+  for (c = 0; c < 256; c++) {
+    if (SPECIAL_CHARS[c]) {
+      cmark_simd_set_add(&SPECIAL_SET, (unsigned char)c);
+      cmark_simd_set_add(&SPECIAL_SMART_SET, (unsigned char)c);
+    } else if (SMART_PUNCT_CHARS[c]) {
+      cmark_simd_set_add(&SPECIAL_SMART_SET, (unsigned char)c);
+    }
+  }
+
+  SPECIAL_SETS_STALE = false;
+}
+
 static bufsize_t subject_find_special_char(subject *subj, int options) {
   bufsize_t n = subj->pos + 1;
 
+  if (n < subj->input.len) {
+    const unsigned char *start = subj->input.data + n;
+    const unsigned char *end = subj->input.data + subj->input.len;
+
+    if (SPECIAL_SETS_STALE)
+      build_special_sets();
+
+    n += (bufsize_t)(cmark_simd_set_find(options & CMARK_OPT_SMART
+                                             ? &SPECIAL_SMART_SET
+                                             : &SPECIAL_SET,
+                                         start, end) -
+                     start);
+  }
+
   while (n < subj->input.len) {
     if (SPECIAL_CHARS[subj->input.data[n]])
       return n;
@@ -1327,12 +1366,14 @@ static bufsize_t subject_find_special_char(subject *subj, int options) {
 
 void cmark_inlines_add_special_character(unsigned char c, bool emphasis) {
   SPECIAL_CHARS[c] = 1;
+  SPECIAL_SETS_STALE = true;
   if (emphasis)
     SKIP_CHARS[c] = 1;
 }
 
 void cmark_inlines_remove_special_character(unsigned char c, bool emphasis) {
   SPECIAL_CHARS[c] = 0;
+  SPECIAL_SETS_STALE = true;
   if (emphasis)
     SKIP_CHARS[c] = 0;
 }
@@ -0,0 +1,324 @@
+#ifndef CMARK_SIMD_H
+#define CMARK_SIMD_H
+
+// Vectorized byte scanners for the parser's and renderer's hot loops.
+//
+// Each scanner looks at 16 bytes at a time and returns a pointer to the
+// first byte it is looking for.  Once fewer than 16 bytes remain it stops
+// and returns a pointer to the start of that tail, so callers always
+// finish with their own byte-at-a-time loop.  That loop stays the single
+// source of truth for what matches, and the scanners only decide how much
+// of the input can be skipped over safely.
+//
+// SSE2 is used on x86 (it is part of the x86-64 baseline), and NEON on
+// ARM.  Scanning for an arbitrary set of bytes needs a byte shuffle, which
+// on x86 means SSSE3; that is detected at run time, since builds target
+// the baseline.  Elsewhere the scanners return their input unchanged and
+// the callers' scalar loops do all of the work.
+
+#include <stdint.h>
+#include "config.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) ||              \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#define CMARK_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define CMARK_SIMD_NEON 1
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define CMARK_SIMD_NEON_TBL 1
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CMARK_SIMD_WIDTH 16
+
+// A set of ASCII bytes to scan for, stored as a pair of 16-entry tables
+// indexed by the low and high nibble of a byte.  A byte is in the set when
+// lo[byte & 0xF] & hi[byte >> 4] is non-zero.  Since every ASCII high
+// nibble gets its own bit in hi, the test is exact.
+typedef struct {
+  bool usable;
+  unsigned char lo[16];
+  unsigned char hi[16];
+} cmark_simd_set;
+
+#if defined(CMARK_SIMD_SSE2)
+
+static CMARK_INLINE int cmark_simd_ctz(uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (int)index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+#elif defined(CMARK_SIMD_NEON)
+
+// NEON has no movemask instruction.  Narrowing each 16-bit lane by 4 bits
+// instead yields a 64-bit mask with 4 bits per byte.
+static CMARK_INLINE uint64_t cmark_simd_neon_mask(uint8x16_t matches) {
+  uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+static CMARK_INLINE int cmark_simd_ctz64(uint64_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return (int)index;
+#else
+  return __builtin_ctzll(mask);
+#endif
+}
+
+#endif
+
+// Returns a pointer to the first '\n', '\r' or '\0' in [p, end), or to the
+// start of the scalar tail if there is none before it.
+static CMARK_INLINE const unsigned char *
+cmark_simd_find_line_end(const unsigned char *p, const unsigned char *end) {
+#if defined(CMARK_SIMD_SSE2)
+  const __m128i lf = _mm_set1_epi8('\n');
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i nul = _mm_setzero_si128();
+
+  while (end - p >= CMARK_SIMD_WIDTH) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)),
+        _mm_cmpeq_epi8(v, nul));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+
+    if (mask)
+      return p + cmark_simd_ctz(mask);
+    p += CMARK_SIMD_WIDTH;
+  }
+#elif defined(CMARK_SIMD_NEON)
+  const uint8x16_t lf = vdupq_n_u8('\n');
+  const uint8x16_t cr = vdupq_n_u8('\r');
+  const uint8x16_t nul = vdupq_n_u8(0);
+
+  while (end - p >= CMARK_SIMD_WIDTH) {
+    uint8x16_t v = vld1q_u8(p);
+    uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(v, lf), vceqq_u8(v, cr)),
+                               vceqq_u8(v, nul));
+    uint64_t mask = cmark_simd_neon_mask(hits);
+
+    if (mask)
+      return p + (cmark_simd_ctz64(mask) >> 2);
+    p += CMARK_SIMD_WIDTH;
+  }
+#else
+  (void)end;
+#endif
+  return p;
+}
+
+// Returns a pointer to the first byte in [p, end) that is not c, or to the
+// start of the scalar tail if there is none before it.
+static CMARK_INLINE const unsigned char *
+cmark_simd_skip_char(const unsigned char *p, const unsigned char *end,
+                     unsigned char c) {
+#if defined(CMARK_SIMD_SSE2)
+  const __m128i needle = _mm_set1_epi8((char)c);
+
+  while (end - p >= CMARK_SIMD_WIDTH) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    uint32_t mask =
+        (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)) ^ 0xFFFFu;
+
+    if (mask)
+      return p + cmark_simd_ctz(mask);
+    p += CMARK_SIMD_WIDTH;
+  }
+#elif defined(CMARK_SIMD_NEON)
+  const uint8x16_t needle = vdupq_n_u8(c);
+
+  while (end - p >= CMARK_SIMD_WIDTH) {
+    uint8x16_t v = vld1q_u8(p);
+    uint64_t mask = ~cmark_simd_neon_mask(vceqq_u8(v, needle));
+
+    if (mask)
+      return p + (cmark_simd_ctz64(mask) >> 2);
+    p += CMARK_SIMD_WIDTH;
+  }
+#else
+  (void)end;
+  (void)c;
+#endif
+  return p;
+}
+
+// Returns a pointer to the first occurrence of any of the bytes a, b, c and
+// d in [p, end), or to the start of the scalar tail if there is none
+// before it.
+static CMARK_INLINE const unsigned char *
+cmark_simd_find_any4(const unsigned char *p, const unsigned char *end,
+                     unsigned char a, unsigned char b, unsigned char c,
+                     unsigned char d) {
+#if defined(CMARK_SIMD_SSE2)
+  const __m128i va = _mm_set1_epi8((char)a);
+  const __m128i vb = _mm_set1_epi8((char)b);
+  const __m128i vc = _mm_set1_epi8((char)c);
+  const __m128i vd = _mm_set1_epi8((char)d);
+
+  while (end - p >= CMARK_SIMD_WIDTH) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)),
+        _mm_or_si128(_mm_cmpeq_epi8(v, vc), _mm_cmpeq_epi8(v, vd)));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+
+    if (mask)
+      return p + cmark_simd_ctz(mask);
+    p += CMARK_SIMD_WIDTH;
+  }
+#elif defined(CMARK_SIMD_NEON)
+  const uint8x16_t va = vdupq_n_u8(a);
+  const uint8x16_t vb = vdupq_n_u8(b);
+  const uint8x16_t vc = vdupq_n_u8(c);
+  const uint8x16_t vd = vdupq_n_u8(d);
+
+  while (end - p >= CMARK_SIMD_WIDTH) {
+    uint8x16_t v = vld1q_u8(p);
+    uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb)),
+                               vorrq_u8(vceqq_u8(v, vc), vceqq_u8(v, vd)));
+    uint64_t mask = cmark_simd_neon_mask(hits);
+
+    if (mask)
+      return p + (cmark_simd_ctz64(mask) >> 2);
+    p += CMARK_SIMD_WIDTH;
+  }
+#else
+  (void)end;
+  (void)a;
+  (void)b;
+  (void)c;
+  (void)d;
+#endif
+  return p;
+}
+
+static CMARK_INLINE void cmark_simd_set_clear(cmark_simd_set *set) {
+  int i;
+
+  set->usable = true;
+
+  for (i = 0; i < 16; i++) {
+    set->lo[i] = 0;
+    set->hi[i] = (unsigned char)(i < 8 ? 1 << i : 0);
+  }
+}
+
+// Adds c to the set.  Only ASCII bytes fit in the tables, so adding any
+// other byte marks the set as unusable, and cmark_simd_set_find then
+// skips nothing.
+static CMARK_INLINE void cmark_simd_set_add(cmark_simd_set *set,
+                                            unsigned char c) {
+  if (c >= 0x80) {
+    set->usable = false;
+    return;
+  }
+
+  set->lo[c & 0xF] |= (unsigned char)(1 << (c >> 4));
+}
+
+#if defined(CMARK_SIMD_SSE2)
+
+static CMARK_INLINE bool cmark_simd_has_ssse3(void) {
+  static int has_ssse3 = -1;
+
+  if (has_ssse3 < 0) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    has_ssse3 = (info[2] & (1 << 9)) != 0;
+#else
+    __builtin_cpu_init();
+    has_ssse3 = __builtin_cpu_supports("ssse3") != 0;
+#endif
+  }
+
+  return has_ssse3 != 0;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("ssse3")))
+#endif
+static CMARK_INLINE const unsigned char *
+cmark_simd_set_find_ssse3(const cmark_simd_set *set, const unsigned char *p,
+                          const unsigned char *end) {
+  const __m128i lo = _mm_loadu_si128((const __m128i *)set->lo);
+  const __m128i hi = _mm_loadu_si128((const __m128i *)set->hi);
+  const __m128i nibble = _mm_set1_epi8(0xF);
+  const __m128i zero = _mm_setzero_si128();
+
+  while (end - p >= CMARK_SIMD_WIDTH) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    __m128i lo_bits = _mm_shuffle_epi8(lo, _mm_and_si128(v, nibble));
+    __m128i hi_bits =
+        _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+    __m128i misses = _mm_cmpeq_epi8(_mm_and_si128(lo_bits, hi_bits), zero);
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(misses) ^ 0xFFFFu;
+
+    if (mask)
+      return p + cmark_simd_ctz(mask);
+    p += CMARK_SIMD_WIDTH;
+  }
+
+  return p;
+}
+
+#endif
+
+// Returns a pointer to the first byte in [p, end) that is in the set, or to
+// the start of the scalar tail if there is none before it.
+static CMARK_INLINE const unsigned char *
+cmark_simd_set_find(const cmark_simd_set *set, const unsigned char *p,
+                    const unsigned char *end) {
+  if (!set->usable)
+    return p;
+
+#if defined(CMARK_SIMD_SSE2)
+  if (cmark_simd_has_ssse3())
+    return cmark_simd_set_find_ssse3(set, p, end);
+#elif defined(CMARK_SIMD_NEON_TBL)
+  {
+    const uint8x16_t lo = vld1q_u8(set->lo);
+    const uint8x16_t hi = vld1q_u8(set->hi);
+    const uint8x16_t nibble = vdupq_n_u8(0xF);
+
+    while (end - p >= CMARK_SIMD_WIDTH) {
+      uint8x16_t v = vld1q_u8(p);
+      uint8x16_t lo_bits = vqtbl1q_u8(lo, vandq_u8(v, nibble));
+      uint8x16_t hi_bits = vqtbl1q_u8(hi, vshrq_n_u8(v, 4));
+      uint64_t mask = cmark_simd_neon_mask(vtstq_u8(lo_bits, hi_bits));
+
+      if (mask)
+        return p + (cmark_simd_ctz64(mask) >> 2);
+      p += CMARK_SIMD_WIDTH;
+    }
+  }
+#else
+  (void)end;
+#endif
+  return p;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
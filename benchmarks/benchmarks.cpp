@@ -0,0 +1,305 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QFont>
+#include <QScopedPointer>
+#include <QStringList>
+#include <QStringRef>
+#include <QTest>
+
+#include "3rdparty/cmark-gfm/src/cmark-gfm-extension_api.h"
+#include "3rdparty/cmark-gfm/src/houdini.h"
+#include "3rdparty/cmark-gfm/extensions/cmark-gfm-core-extensions.h"
+
+#include "cmarkgfmapi.h"
+#include "documentstatistics.h"
+#include "markdownast.h"
+#include "markdowndocument.h"
+#include "markdowneditor.h"
+#include "markdownhighlighter.h"
+#include "stylesheetbuilder.h"
+#include "themerepository.h"
+#include "spelling/abstract_dictionary.h"
+
+#ifndef Q_OS_MAC
+#include "spelling/dictionary_provider_hunspell.h"
+#endif
+
+#include "benchmarks.h"
+#include "corpusgenerator.h"
+
+namespace ghostwriter
+{
+// Number of lines looked up per iteration of the findBlockAtLine benchmark.
+static const int LINE_LOOKUP_COUNT = 1000;
+
+void Benchmarks::initTestCase()
+{
+    // Registers the cmark-gfm extensions.
+    CmarkGfmAPI::instance();
+}
+
+void Benchmarks::parse_data()
+{
+    addDocumentSizes();
+}
+
+void Benchmarks::parse()
+{
+    QFETCH(int, size);
+    const QString &text = corpus(size);
+
+    QBENCHMARK {
+        delete CmarkGfmAPI::instance()->parse(text, false);
+    }
+}
+
+void Benchmarks::renderToHtml_data()
+{
+    addDocumentSizes();
+}
+
+void Benchmarks::renderToHtml()
+{
+    QFETCH(int, size);
+    const QString &text = corpus(size);
+
+    QBENCHMARK {
+        CmarkGfmAPI::instance()->renderToHtml(text, false);
+    }
+}
+
+void Benchmarks::escapeHtml_data()
+{
+    addDocumentSizes();
+}
+
+void Benchmarks::escapeHtml()
+{
+    QFETCH(int, size);
+    QByteArray text = corpus(size).toUtf8();
+    cmark_mem *mem = cmark_get_default_mem_allocator();
+
+    QBENCHMARK {
+        cmark_strbuf html;
+
+        cmark_strbuf_init(mem, &html, 0);
+        houdini_escape_html0
+        (
+            &html,
+            (const uint8_t *) text.constData(),
+            text.length(),
+            0
+        );
+        cmark_strbuf_free(&html);
+    }
+}
+
+void Benchmarks::setRoot_data()
+{
+    addDocumentSizes();
+}
+
+void Benchmarks::setRoot()
+{
+    QFETCH(int, size);
+    QByteArray text = corpus(size).toUtf8();
+
+    // Parse with the default allocator rather than CmarkGfmAPI's arena,
+    // which is reset after every parse.
+    int opts = CMARK_OPT_DEFAULT | CMARK_OPT_FOOTNOTES | CMARK_OPT_UNSAFE;
+    cmark_parser *parser = cmark_parser_new(opts);
+    const char *extensions[] =
+        { "table", "strikethrough", "autolink", "tagfilter", "tasklist" };
+
+    for (const char *name : extensions) {
+        cmark_parser_attach_syntax_extension
+        (
+            parser,
+            cmark_find_syntax_extension(name)
+        );
+    }
+
+    cmark_parser_feed(parser, text.data(), text.length());
+    cmark_node *root = cmark_parser_finish(parser);
+
+    MarkdownAST ast;
+
+    QBENCHMARK {
+        ast.setRoot(root);
+    }
+
+    cmark_node_free(root);
+    cmark_parser_free(parser);
+}
+
+void Benchmarks::findBlockAtLine_data()
+{
+    addDocumentSizes();
+}
+
+void Benchmarks::findBlockAtLine()
+{
+    QFETCH(int, size);
+    const QString &text = corpus(size);
+    QScopedPointer<MarkdownAST> ast(CmarkGfmAPI::instance()->parse(text, false));
+    int lineCount = text.count('\n') + 1;
+
+    QBENCHMARK {
+        for (int i = 0; i < LINE_LOOKUP_COUNT; i++) {
+            ast->findBlockAtLine(1 + (int)((qint64)i * lineCount / LINE_LOOKUP_COUNT));
+        }
+    }
+}
+
+void Benchmarks::highlightBlock_data()
+{
+    addDocumentSizes();
+}
+
+void Benchmarks::highlightBlock()
+{
+    QFETCH(int, size);
+    ColorScheme colors =
+        ThemeRepository::instance()->defaultTheme().lightColorScheme();
+
+    MarkdownDocument document(corpus(size));
+    MarkdownEditor editor(&document, colors);
+
+    document.setMarkdownAST(CmarkGfmAPI::instance()->parse(corpus(size), false));
+
+    // The editor's own highlighter is private, so attach a second one and
+    // time only that.  rehighlight() calls highlightBlock() for every
+    // block in the document.
+    MarkdownHighlighter highlighter(&editor, colors);
+
+    QBENCHMARK {
+        highlighter.rehighlight();
+    }
+}
+
+void Benchmarks::countWordsAndSentences_data()
+{
+    addDocumentSizes();
+}
+
+void Benchmarks::countWordsAndSentences()
+{
+    QFETCH(int, size);
+    const QString &text = corpus(size);
+
+    // Counting a selection runs countWords() and countSentences() over
+    // the selected text in one go.
+    MarkdownDocument document;
+    DocumentStatistics statistics(&document);
+
+    QBENCHMARK {
+        statistics.onTextSelected(text, 0, 0);
+    }
+}
+
+void Benchmarks::spellCheck_data()
+{
+    addDocumentSizes();
+}
+
+void Benchmarks::spellCheck()
+{
+#ifdef Q_OS_MAC
+    QSKIP("Hunspell is not used on macOS");
+#else
+    QFETCH(int, size);
+    const QString &text = corpus(size);
+
+    DictionaryProviderHunspell provider;
+    QStringList languages = provider.availableDictionaries();
+
+    if (languages.isEmpty()) {
+        QSKIP("No Hunspell dictionaries are installed");
+    }
+
+    QString language =
+        languages.contains("en_US") ? QString("en_US") : languages.first();
+    QScopedPointer<AbstractDictionary> dictionary(provider.requestDictionary(language));
+
+    if (!dictionary->isValid()) {
+        QSKIP("The Hunspell dictionary could not be loaded");
+    }
+
+    QBENCHMARK {
+        int start = 0;
+        QStringRef misspelled = dictionary->check(text, start);
+
+        while (!misspelled.isNull()) {
+            start = misspelled.position() + misspelled.length();
+            misspelled = dictionary->check(text, start);
+        }
+    }
+#endif
+}
+
+void Benchmarks::styleSheetBuilder_data()
+{
+    QTest::addColumn<bool>("memoized");
+
+    QTest::newRow("cold") << false;
+    QTest::newRow("memoized") << true;
+}
+
+void Benchmarks::styleSheetBuilder()
+{
+    QFETCH(bool, memoized);
+    ColorScheme colors =
+        ThemeRepository::instance()->defaultTheme().lightColorScheme();
+    QFont textFont("Roboto", 12);
+    QFont codeFont("Roboto Mono", 12);
+
+    StyleSheetBuilder::clearCache();
+
+    QBENCHMARK {
+        if (!memoized) {
+            StyleSheetBuilder::clearCache();
+        }
+
+        StyleSheetBuilder builder(colors, true, textFont, codeFont);
+    }
+
+    StyleSheetBuilder::clearCache();
+}
+
+void Benchmarks::addDocumentSizes()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("10KB") << 10 * 1024;
+    QTest::newRow("1MB") << 1024 * 1024;
+    QTest::newRow("20MB") << 20 * 1024 * 1024;
+}
+
+const QString &Benchmarks::corpus(int size)
+{
+    if (!corpora.contains(size)) {
+        corpora.insert(size, CorpusGenerator().generate(size));
+    }
+
+    return corpora[size];
+}
+} // namespace ghostwriter
+
+QTEST_MAIN(ghostwriter::Benchmarks)
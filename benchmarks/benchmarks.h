@@ -0,0 +1,86 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+namespace ghostwriter
+{
+/**
+ * QtTest benchmarks for the editing pipeline's hot paths.  Each
+ * document-sized benchmark runs over generated documents of 10 KB, 1 MB
+ * and 20 MB.  Run with "-o benchmarks.xml,xml" for machine-readable
+ * results, or with a function and data tag (e.g., "parse:1MB") to run a
+ * single benchmark.
+ */
+class Benchmarks : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void parse_data();
+    void parse();
+
+    void renderToHtml_data();
+    void renderToHtml();
+
+    void escapeHtml_data();
+    void escapeHtml();
+
+    void setRoot_data();
+    void setRoot();
+
+    void findBlockAtLine_data();
+    void findBlockAtLine();
+
+    void highlightBlock_data();
+    void highlightBlock();
+
+    void countWordsAndSentences_data();
+    void countWordsAndSentences();
+
+    void spellCheck_data();
+    void spellCheck();
+
+    void styleSheetBuilder_data();
+    void styleSheetBuilder();
+
+private:
+    QHash<int, QString> corpora;
+
+    /*
+    * Adds the document size column and the 10 KB, 1 MB and 20 MB rows.
+    */
+    void addDocumentSizes();
+
+    /*
+    * Returns the generated document of the given size, generating it on
+    * first use.
+    */
+    const QString &corpus(int size);
+};
+} // namespace ghostwriter
+
+#endif // BENCHMARKS_H
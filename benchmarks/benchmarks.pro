@@ -0,0 +1,51 @@
+################################################################################
+#
+# Copyright (C) 2022 wereturtle
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+################################################################################
+
+# Performance benchmarks for ghostwriter's editing pipeline.  Build and run
+# them from the top-level project with "make benchmarks", which writes the
+# results to benchmarks.xml, or run the benchmarks executable directly with
+# any of the usual QtTest options.
+
+TEMPLATE = app
+
+QT += testlib widgets concurrent svg webenginewidgets webengine webchannel gui
+
+CONFIG += warn_on
+CONFIG += c++11
+CONFIG -= app_bundle
+
+DEFINES += APPVERSION='\\"benchmarks\\"'
+DEFINES += QT_NO_DEBUG_OUTPUT=1
+
+TARGET = benchmarks
+
+CONFIG+=fontAwesomeFree
+include(../3rdparty/QtAwesome/QtAwesome.pri)
+include(../3rdparty/cmark-gfm/cmark-gfm.pri)
+include(../src/src.pri)
+
+HEADERS += \
+    benchmarks.h \
+    corpusgenerator.h
+
+SOURCES += \
+    benchmarks.cpp \
+    corpusgenerator.cpp
+
+RESOURCES += ../resources.qrc
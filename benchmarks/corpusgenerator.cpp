@@ -0,0 +1,294 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QStringList>
+
+#include "corpusgenerator.h"
+
+namespace ghostwriter
+{
+// Mostly English words, with some accented, Greek, Cyrillic, CJK and emoji
+// words for Unicode coverage and a few misspellings for the spell checker.
+static const char *const VOCABULARY[] = {
+    "the", "of", "and", "a", "to", "in", "is", "was", "that", "for",
+    "it", "with", "as", "his", "on", "be", "at", "by", "had", "not",
+    "writer", "ghost", "document", "paragraph", "sentence", "chapter",
+    "morning", "harbour", "lantern", "quietly", "remembered", "window",
+    "distance", "whispered", "mountain", "afterwards", "question",
+    "extraordinary", "notwithstanding", "characteristically",
+    "well-known", "self-evident", "twenty-one", "1984", "3.14",
+    "naïve", "café", "façade", "über", "señor", "smörgåsbord",
+    "λόγος", "Москва", "日本語", "文章", "😀", "✍️",
+    "teh", "recieve", "seperate", "occured"
+};
+
+static const int VOCABULARY_SIZE = sizeof(VOCABULARY) / sizeof(VOCABULARY[0]);
+
+static const char *const CODE_LINES[] = {
+    "int main(int argc, char *argv[])",
+    "{",
+    "    QString text = QString(\"<b>%1</b> & more\").arg(argc);",
+    "    for (int i = 0; i < argc; i++) {",
+    "        qDebug() << argv[i] << \"*not emphasis*\";",
+    "    }",
+    "    return 0;",
+    "}"
+};
+
+static const int CODE_LINES_SIZE = sizeof(CODE_LINES) / sizeof(CODE_LINES[0]);
+
+CorpusGenerator::CorpusGenerator(quint32 seed)
+    : state(seed ? seed : 1), footnoteCount(0)
+{
+    ;
+}
+
+CorpusGenerator::~CorpusGenerator()
+{
+    ;
+}
+
+QString CorpusGenerator::generate(int size)
+{
+    QString text;
+
+    text.reserve(size + 4096);
+    footnoteCount = 0;
+
+    while (text.length() < size) {
+        int kind = bounded(100);
+
+        if (kind < 50) {
+            appendParagraph(text);
+        } else if (kind < 60) {
+            appendHeading(text);
+        } else if (kind < 72) {
+            appendList(text);
+        } else if (kind < 78) {
+            appendBlockquote(text);
+        } else if (kind < 86) {
+            appendTable(text);
+        } else if (kind < 94) {
+            appendCodeBlock(text);
+        } else {
+            appendFootnote(text);
+        }
+
+        text += '\n';
+    }
+
+    return text;
+}
+
+// xorshift32, which gives the same sequence everywhere, unlike qrand().
+quint32 CorpusGenerator::next()
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+int CorpusGenerator::bounded(int limit)
+{
+    return (int)(next() % (quint32)limit);
+}
+
+bool CorpusGenerator::chance(int percent)
+{
+    return bounded(100) < percent;
+}
+
+QString CorpusGenerator::word()
+{
+    return QString::fromUtf8(VOCABULARY[bounded(VOCABULARY_SIZE)]);
+}
+
+QString CorpusGenerator::sentence()
+{
+    int length = 4 + bounded(14);
+    QString text = word();
+
+    text[0] = text[0].toUpper();
+
+    for (int i = 1; i < length; i++) {
+        QString w = word();
+        int markup = bounded(100);
+
+        text += ' ';
+
+        if (markup < 4) {
+            text += '*' + w + '*';
+        } else if (markup < 7) {
+            text += "**" + w + "**";
+        } else if (markup < 9) {
+            text += '`' + w + '`';
+        } else if (markup < 10) {
+            text += '[' + w + "](https://example.com/" + w + ')';
+        } else if (markup < 11) {
+            text += "~~" + w + "~~";
+        } else {
+            text += w;
+        }
+    }
+
+    switch (bounded(4)) {
+    case 0:
+        text += '?';
+        break;
+    case 1:
+        text += '!';
+        break;
+    default:
+        text += '.';
+        break;
+    }
+
+    return text;
+}
+
+void CorpusGenerator::appendParagraph(QString &text)
+{
+    int sentences = 1 + bounded(6);
+
+    for (int i = 0; i < sentences; i++) {
+        text += sentence();
+
+        // Break some paragraphs over several lines, as hard-wrapped
+        // Markdown often is.
+        text += chance(30) ? '\n' : ' ';
+    }
+
+    text += '\n';
+}
+
+void CorpusGenerator::appendHeading(QString &text)
+{
+    QString title = sentence();
+
+    title.chop(1);
+
+    if (chance(20)) {
+        text += title + '\n' + QString(title.length(), '=') + '\n';
+    } else {
+        text += QString(1 + bounded(6), '#') + ' ' + title + '\n';
+    }
+}
+
+void CorpusGenerator::appendList(QString &text)
+{
+    int items = 2 + bounded(8);
+    bool numbered = chance(40);
+    bool tasks = !numbered && chance(25);
+
+    for (int i = 0; i < items; i++) {
+        QString indent = (i > 0 && chance(20)) ? "    " : "";
+
+        text += indent;
+
+        if (numbered) {
+            text += QString::number(i + 1) + ". ";
+        } else {
+            text += "- ";
+
+            if (tasks) {
+                text += chance(50) ? "[x] " : "[ ] ";
+            }
+        }
+
+        text += sentence() + '\n';
+    }
+}
+
+void CorpusGenerator::appendBlockquote(QString &text)
+{
+    int lines = 1 + bounded(4);
+
+    for (int i = 0; i < lines; i++) {
+        text += "> " + sentence() + '\n';
+    }
+}
+
+void CorpusGenerator::appendTable(QString &text)
+{
+    int columns = 2 + bounded(7);
+    int rows = 2 + bounded(20);
+    QStringList cells;
+
+    for (int c = 0; c < columns; c++) {
+        cells << word();
+    }
+
+    text += "| " + cells.join(" | ") + " |\n";
+    cells.clear();
+
+    for (int c = 0; c < columns; c++) {
+        switch (bounded(4)) {
+        case 0:
+            cells << ":---";
+            break;
+        case 1:
+            cells << "---:";
+            break;
+        case 2:
+            cells << ":---:";
+            break;
+        default:
+            cells << "---";
+            break;
+        }
+    }
+
+    text += '|' + cells.join('|') + "|\n";
+
+    for (int r = 0; r < rows; r++) {
+        cells.clear();
+
+        for (int c = 0; c < columns; c++) {
+            cells << (chance(10) ? QString("a \\| b") : word());
+        }
+
+        text += "| " + cells.join(" | ") + " |\n";
+    }
+}
+
+void CorpusGenerator::appendCodeBlock(QString &text)
+{
+    int lines = 2 + bounded(12);
+
+    text += chance(50) ? "```cpp\n" : "```\n";
+
+    for (int i = 0; i < lines; i++) {
+        text += QString::fromUtf8(CODE_LINES[bounded(CODE_LINES_SIZE)]);
+        text += '\n';
+    }
+
+    text += "```\n";
+}
+
+void CorpusGenerator::appendFootnote(QString &text)
+{
+    footnoteCount++;
+
+    QString label = QString::number(footnoteCount);
+
+    text += sentence() + "[^" + label + "] " + sentence() + "\n\n";
+    text += "[^" + label + "]: " + sentence() + '\n';
+}
+} // namespace ghostwriter
@@ -0,0 +1,74 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef CORPUS_GENERATOR_H
+#define CORPUS_GENERATOR_H
+
+#include <QString>
+
+namespace ghostwriter
+{
+/**
+ * Generates synthetic Markdown documents for the benchmarks.  The output
+ * mixes prose, headings, lists, block quotes, tables, fenced code blocks,
+ * footnotes and non-ASCII text.  It depends only on the seed, so the same
+ * seed and size produce the same document on every platform and Qt
+ * version.
+ */
+class CorpusGenerator
+{
+public:
+    /**
+     * Constructor.  Takes the seed for the generator.
+     */
+    CorpusGenerator(quint32 seed = 1);
+
+    /**
+     * Destructor.
+     */
+    ~CorpusGenerator();
+
+    /**
+     * Generates a document of at least the given number of characters.
+     * The document ends at a block boundary, so it may be slightly
+     * longer than requested.
+     */
+    QString generate(int size);
+
+private:
+    quint32 state;
+    int footnoteCount;
+
+    quint32 next();
+    int bounded(int limit);
+    bool chance(int percent);
+
+    QString word();
+    QString sentence();
+    void appendParagraph(QString &text);
+    void appendHeading(QString &text);
+    void appendList(QString &text);
+    void appendBlockquote(QString &text);
+    void appendTable(QString &text);
+    void appendCodeBlock(QString &text);
+    void appendFootnote(QString &text);
+};
+} // namespace ghostwriter
+
+#endif // CORPUS_GENERATOR_H
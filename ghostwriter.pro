@@ -46,6 +46,12 @@ else {
 }
 
 DEFINES += QT_NO_DEBUG_OUTPUT=1
+
+# Build with "qmake CONFIG+=notracing" to compile out the trace probes.
+notracing {
+    DEFINES += GW_DISABLE_TRACING
+}
+
 OBJECTS_DIR = $${DESTDIR}
 MOC_DIR = $${DESTDIR}
 RCC_DIR = $${DESTDIR}
@@ -61,135 +67,11 @@ include(3rdparty/cmark-gfm/cmark-gfm.pri)
 
 macx {
     QMAKE_MACOSX_DEPLOYMENT_TARGET = 10.10
-
-    LIBS += -framework AppKit
-
-    HEADERS += src/spelling/dictionary_provider_nsspellchecker.h
-
-    OBJECTIVE_SOURCES += src/spelling/dictionary_provider_nsspellchecker.mm
-} else:win32 {
-    include(3rdparty/hunspell/hunspell.pri)
-
-    HEADERS += src/spelling/dictionary_provider_hunspell.h \
-        src/spelling/dictionary_provider_voikko.h
-
-    SOURCES += src/spelling/dictionary_provider_hunspell.cpp \
-        src/spelling/dictionary_provider_voikko.cpp
-
-} else:unix {
-    CONFIG += link_pkgconfig
-    PKGCONFIG += hunspell
-    
-    HEADERS += src/spelling/dictionary_provider_hunspell.h \
-        src/spelling/dictionary_provider_voikko.h
-
-    SOURCES += src/spelling/dictionary_provider_hunspell.cpp \
-        src/spelling/dictionary_provider_voikko.cpp
 }
 
-INCLUDEPATH += src src/spelling
-
-HEADERS += \
-    src/abstractstatisticswidget.h \
-    src/appsettings.h \
-    src/cmarkgfmapi.h \
-    src/cmarkgfmexporter.h \
-    src/colorscheme.h \
-    src/colorschemepreviewer.h \
-    src/commandlineexporter.h \
-    src/documenthistory.h \
-    src/documentmanager.h \
-    src/documentstatistics.h \
-    src/documentstatisticswidget.h \
-    src/exportdialog.h \
-    src/exporter.h \
-    src/exporterfactory.h \
-    src/exportformat.h \
-    src/htmlpreview.h \
-    src/localedialog.h \
-    src/mainwindow.h \
-    src/markdowndocument.h \
-    src/markdowneditor.h \
-    src/markdowneditortypes.h \
-    src/markdownhighlighter.h \
-    src/markdownast.h \
-    src/markdownnode.h \
-    src/markdownstates.h \
-    src/memoryarena.h \
-    src/messageboxhelper.h \
-    src/outlinewidget.h \
-    src/preferencesdialog.h \
-    src/previewoptionsdialog.h \
-    src/sandboxedwebpage.h \
-    src/sessionstatistics.h \
-    src/sessionstatisticswidget.h \
-    src/sidebar.h \
-    src/simplefontdialog.h \
-    src/statisticsindicator.h \
-    src/dictionaryindicator.h \
-    src/stringobserver.h \
-    src/stylesheetbuilder.h \
-    src/textblockdata.h \
-    src/theme.h \
-    src/themeeditordialog.h \
-    src/themerepository.h \
-    src/themeselectiondialog.h \
-    src/timelabel.h \
-    src/findreplace.h \
-    src/color_button.h \
-    src/spelling/abstract_dictionary.h \
-    src/spelling/abstract_dictionary_provider.h \
-    src/spelling/dictionary_manager.h \
-    src/spelling/dictionary_ref.h \
-    src/spelling/spell_checker.h
-
-SOURCES += \
-    src/abstractstatisticswidget.cpp \
-    src/appmain.cpp \
-    src/appsettings.cpp \
-    src/cmarkgfmapi.cpp \
-    src/cmarkgfmexporter.cpp \
-    src/colorschemepreviewer.cpp \
-    src/commandlineexporter.cpp \
-    src/documenthistory.cpp \
-    src/documentmanager.cpp \
-    src/documentstatistics.cpp \
-    src/documentstatisticswidget.cpp \
-    src/exportdialog.cpp \
-    src/exporter.cpp \
-    src/exporterfactory.cpp \
-    src/exportformat.cpp \
-    src/htmlpreview.cpp \
-    src/localedialog.cpp \
-    src/mainwindow.cpp \
-    src/markdowndocument.cpp \
-    src/markdowneditor.cpp \
-    src/markdownhighlighter.cpp \
-    src/markdownast.cpp \
-    src/markdownnode.cpp \
-    src/memoryarena.cpp \
-    src/messageboxhelper.cpp \
-    src/outlinewidget.cpp \
-    src/preferencesdialog.cpp \
-    src/previewoptionsdialog.cpp \
-    src/sandboxedwebpage.cpp \
-    src/sessionstatistics.cpp \
-    src/sessionstatisticswidget.cpp \
-    src/sidebar.cpp \
-    src/simplefontdialog.cpp \
-    src/statisticsindicator.cpp \
-    src/dictionaryindicator.cpp \
-    src/stringobserver.cpp \
-    src/stylesheetbuilder.cpp \
-    src/theme.cpp \
-    src/themeeditordialog.cpp \
-    src/themerepository.cpp \
-    src/themeselectiondialog.cpp \
-    src/timelabel.cpp \
-    src/color_button.cpp \
-    src/findreplace.cpp \
-    src/spelling/dictionary_manager.cpp \
-    src/spelling/spell_checker.cpp
+include(src/src.pri)
+
+SOURCES += src/appmain.cpp
 
 # Generate translations
 TRANSLATIONS = $$files(translations/ghostwriter_*.ts)
@@ -202,6 +84,15 @@ QMAKE_EXTRA_COMPILERS += updateqm
 
 RESOURCES += resources.qrc
 
+# "make benchmarks" builds the QtTest benchmarks in benchmarks/ and runs
+# them, writing the results to benchmarks.xml in the build directory.
+BENCHMARKS_DIR = $$shell_path($$OUT_PWD/benchmarks-build)
+benchmarks.commands = \
+    $(CHK_DIR_EXISTS) $$BENCHMARKS_DIR || $(MKDIR) $$BENCHMARKS_DIR $$escape_expand(\n\t) \
+    cd $$BENCHMARKS_DIR && $$shell_quote($$QMAKE_QMAKE) $$shell_quote($$shell_path($$PWD/benchmarks/benchmarks.pro)) && $(MAKE) $$escape_expand(\n\t) \
+    cd $$BENCHMARKS_DIR && $$shell_path(./benchmarks) -o $$shell_quote($$shell_path($$OUT_PWD/benchmarks.xml)),xml
+QMAKE_EXTRA_TARGETS += benchmarks
+
 macx {
     # generate property list for macOS
     ICON = resources/mac/ghostwriter.icns
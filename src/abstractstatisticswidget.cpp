@@ -40,17 +40,17 @@ AbstractStatisticsWidget::~AbstractStatisticsWidget()
 
 void AbstractStatisticsWidget::setIntegerValueForLabel(QLabel *label, int value)
 {
-    label->setText(QString("<b>%L1</b>").arg(value));
+    setValueText(label, QString("<b>%L1</b>").arg(value));
 }
 
 void AbstractStatisticsWidget::setStringValueForLabel(QLabel *label, const QString &value)
 {
-    label->setText(QString("<b>") + value + "</b>");
+    setValueText(label, QString("<b>") + value + "</b>");
 }
 
 void AbstractStatisticsWidget::setPercentageValueForLabel(QLabel *label, int percentage)
 {
-    label->setText(QString("<b>%L1%</b>").arg(percentage));
+    setValueText(label, QString("<b>%L1%</b>").arg(percentage));
 }
 
 void AbstractStatisticsWidget::setTimeValueForLabel(QLabel *label, unsigned long minutes)
@@ -67,7 +67,7 @@ void AbstractStatisticsWidget::setTimeValueForLabel(QLabel *label, unsigned long
         timeText = QString("<b>") + tr("%1m").arg(minutes) + "</b>";
     }
 
-    label->setText(timeText);
+    setValueText(label, timeText);
 }
 
 void AbstractStatisticsWidget::setPageValueForLabel(QLabel *label, int pages)
@@ -80,7 +80,7 @@ void AbstractStatisticsWidget::setPageValueForLabel(QLabel *label, int pages)
         pagesText = QString("<b>%L1</b>").arg(pages);
     }
 
-    label->setText(pagesText);
+    setValueText(label, pagesText);
 }
 
 QLabel *AbstractStatisticsWidget::addStatisticLabel
@@ -129,4 +129,25 @@ QLabel *AbstractStatisticsWidget::addStatisticLabel
 
     return valueLabel;
 }
+
+void AbstractStatisticsWidget::showEvent(QShowEvent *event)
+{
+    for (auto it = pendingValues.constBegin(); it != pendingValues.constEnd(); it++) {
+        if (it.key()->text() != it.value()) {
+            it.key()->setText(it.value());
+        }
+    }
+
+    pendingValues.clear();
+    QListWidget::showEvent(event);
+}
+
+void AbstractStatisticsWidget::setValueText(QLabel *label, const QString &text)
+{
+    if (!this->isVisible()) {
+        pendingValues.insert(label, text);
+    } else if (label->text() != text) {
+        label->setText(text);
+    }
+}
 }
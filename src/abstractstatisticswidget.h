@@ -20,6 +20,7 @@
 #ifndef ABSTRACTSTATISTICSWIDGET_H
 #define ABSTRACTSTATISTICSWIDGET_H
 
+#include <QHash>
 #include <QListWidget>
 #include <QLabel>
 
@@ -87,6 +88,24 @@ protected:
         const QString &initialValue,
         const QString &toolTip = QString()
     );
+
+    /**
+     * Applies the values set while this widget was hidden.
+     */
+    void showEvent(QShowEvent *event) override;
+
+private:
+    // Value label text set while this widget was hidden, to be applied
+    // once it is shown.
+    //
+    QHash<QLabel *, QString> pendingValues;
+
+    /*
+    * Sets the text of the given value label, unless it is unchanged.
+    * While this widget is hidden, the text is only applied once it is
+    * shown, so that hidden statistics do not cause relayouts.
+    */
+    void setValueText(QLabel *label, const QString &text);
 };
 }
 
@@ -26,9 +26,21 @@
 
 #include "mainwindow.h"
 #include "appsettings.h"
+#include "batchexporter.h"
+#include "trace.h"
 
 int main(int argc, char *argv[])
 {
+    // Headless exports must not create any widgets, so check for them
+    // before a QApplication is constructed.
+    //
+    if (ghostwriter::BatchExporter::isRequested(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        ghostwriter::BatchExporter exporter;
+
+        return exporter.exec(app.arguments());
+    }
+
 #if QT_VERSION >= 0x050600
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
@@ -95,10 +107,43 @@ int main(int argc, char *argv[])
 
     QString filePath = QString();
 
-    if (argc > 1) {
-        filePath = app.arguments().at(1);
+    // A performance trace of the session can be recorded by setting either
+    // the GHOSTWRITER_TRACE environment variable or the --trace option to
+    // the path of the trace file to write on exit.
+    //
+    QString traceFilePath = QString::fromLocal8Bit(qgetenv("GHOSTWRITER_TRACE"));
+    QStringList arguments = app.arguments();
+
+    for (int i = 1; i < arguments.size(); i++) {
+        if ("--trace" == arguments.at(i)) {
+            if ((i + 1) < arguments.size()) {
+                i++;
+                traceFilePath = arguments.at(i);
+            } else {
+                qWarning() << "Missing trace file path for --trace";
+            }
+        } else if (filePath.isNull()) {
+            filePath = arguments.at(i);
+        }
     }
 
+#ifndef GW_DISABLE_TRACING
+    if (!traceFilePath.isEmpty()) {
+        ghostwriter::Tracer::instance()->start(traceFilePath);
+
+        QObject::connect
+        (
+            &app,
+            &QCoreApplication::aboutToQuit,
+            [traceFilePath]() {
+                if (!ghostwriter::Tracer::instance()->stop()) {
+                    qWarning() << "Could not write trace file" << traceFilePath;
+                }
+            }
+        );
+    }
+#endif
+
     ghostwriter::MainWindow window(filePath);
 
     window.show();
@@ -60,6 +60,7 @@
 #define GW_LIVE_SPELL_CHECK_KEY "Spelling/liveSpellCheck"
 #define GW_SIDEBAR_OPEN_KEY "Window/sidebarOpen"
 #define GW_HTML_PREVIEW_OPEN_KEY "Preview/htmlPreviewOpen"
+#define GW_HTML_PREVIEW_TEARDOWN_DELAY_KEY "Preview/teardownDelay"
 #define GW_LAST_USED_EXPORTER_KEY "Preview/lastUsedExporter"
 #define GW_PREVIEW_TEXT_FONT_KEY "Preview/textFont"
 #define GW_PREVIEW_CODE_FONT_KEY "Preview/codeFont"
@@ -94,6 +95,7 @@ public:
     bool fileHistoryEnabled;
     bool hideMenuBarInFullScreenEnabled;
     bool htmlPreviewVisible;
+    int htmlPreviewTeardownDelay;
     bool sidebarVisible;
     bool insertSpacesForTabsEnabled;
     bool largeHeadingSizesEnabled;
@@ -160,6 +162,7 @@ void AppSettings::store()
     appSettings.setValue(GW_LARGE_HEADINGS_KEY, QVariant(d->largeHeadingSizesEnabled));
     appSettings.setValue(GW_SIDEBAR_OPEN_KEY, QVariant(d->sidebarVisible));
     appSettings.setValue(GW_HTML_PREVIEW_OPEN_KEY, QVariant(d->htmlPreviewVisible));
+    appSettings.setValue(GW_HTML_PREVIEW_TEARDOWN_DELAY_KEY, QVariant(d->htmlPreviewTeardownDelay));
     appSettings.setValue(GW_LAST_USED_EXPORTER_KEY, QVariant(d->currentHtmlExporter->name()));
     appSettings.setValue(GW_LIVE_SPELL_CHECK_KEY, QVariant(d->liveSpellCheckEnabled));
     appSettings.setValue(GW_LOCALE_KEY, QVariant(d->locale));
@@ -646,6 +649,13 @@ void AppSettings::setHtmlPreviewVisible(bool visible)
     d->htmlPreviewVisible = visible;
 }
 
+int AppSettings::htmlPreviewTeardownDelay() const
+{
+    Q_D(const AppSettings);
+
+    return d->htmlPreviewTeardownDelay;
+}
+
 bool AppSettings::sidebarVisible() const
 {
     Q_D(const AppSettings);
@@ -875,6 +885,7 @@ AppSettings::AppSettings()
 
     d->sidebarVisible = appSettings.value(GW_SIDEBAR_OPEN_KEY, QVariant(true)).toBool();
     d->htmlPreviewVisible = appSettings.value(GW_HTML_PREVIEW_OPEN_KEY, QVariant(true)).toBool();
+    d->htmlPreviewTeardownDelay = appSettings.value(GW_HTML_PREVIEW_TEARDOWN_DELAY_KEY, QVariant(DEFAULT_HTML_PREVIEW_TEARDOWN_DELAY)).toInt();
 
     QString exporterName = appSettings.value(GW_LAST_USED_EXPORTER_KEY).toString();
     d->currentHtmlExporter = ExporterFactory::instance()->exporterByName(exporterName);
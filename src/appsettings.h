@@ -47,6 +47,7 @@ public:
     static const int MIN_TAB_WIDTH = 1;
     static const int MAX_TAB_WIDTH = 8;
     static const int DEFAULT_TAB_WIDTH = 4;
+    static const int DEFAULT_HTML_PREVIEW_TEARDOWN_DELAY = 5 * 60 * 1000;
 
     static AppSettings *instance();
     ~AppSettings();
@@ -162,6 +163,10 @@ public:
     bool htmlPreviewVisible() const;
     void setHtmlPreviewVisible(bool visible);
 
+    // Milliseconds the hidden HTML preview is kept before it is destroyed,
+    // or a negative value to keep it.  Only set in the settings file.
+    int htmlPreviewTeardownDelay() const;
+
     bool sidebarVisible() const;
     void setSidebarVisible(bool visible);
 
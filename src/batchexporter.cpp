@@ -0,0 +1,433 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QtConcurrentMap>
+#include <stdio.h>
+
+#include "batchexporter.h"
+#include "cmarkgfmapi.h"
+#include "exporter.h"
+#include "exporterfactory.h"
+
+namespace ghostwriter
+{
+/*
+* Exports a single file.  This is run concurrently for many files, so it
+* must not touch any shared state other than the (stateless) exporter.
+*/
+class FileExportTask
+{
+public:
+    typedef QString result_type;
+
+    FileExportTask
+    (
+        Exporter *exporter,
+        const ExportFormat *format,
+        const QString &outputDir
+    ) : exporter(exporter), format(format), outputDir(outputDir)
+    {
+        ;
+    }
+
+    /*
+    * Returns a description of the error encountered, or a null string if
+    * the file was exported successfully.
+    */
+    QString operator()(const QString &filePath) const;
+
+    /*
+    * Returns the path of the file that the given input file is exported
+    * to.
+    */
+    QString outputFilePath(const QString &filePath) const;
+
+private:
+    Exporter *exporter;
+    const ExportFormat *format;
+    QString outputDir;
+};
+
+class BatchExporterPrivate
+{
+public:
+    BatchExporterPrivate()
+        : format("html"), smartTypographyEnabled(false), helpRequested(false)
+    {
+        ;
+    }
+
+    ~BatchExporterPrivate()
+    {
+        ;
+    }
+
+    QString format;
+    QString exporterName;
+    QString outputDir;
+    bool smartTypographyEnabled;
+    bool helpRequested;
+    QStringList inputFiles;
+
+    /*
+    * Parses the command line arguments into the fields above.  Returns
+    * false and sets the err parameter if the arguments are invalid, or
+    * returns false and sets helpRequested if help was requested.
+    */
+    bool parseArguments(const QStringList &arguments, QString &err);
+
+    /*
+    * Finds the exporter to use and the format to export to, preferring
+    * the built-in cmark-gfm exporter if no exporter name was given.
+    * Returns false and sets the err parameter if none is available.
+    */
+    bool findExporter(Exporter *&exporter, const ExportFormat *&format, QString &err) const;
+
+    /*
+    * Returns the matching format supported by the given exporter, or
+    * nullptr if the exporter does not support the requested format.
+    */
+    const ExportFormat *findFormat(const Exporter *exporter) const;
+
+    /*
+    * Returns false and prints an error for each input file that would be
+    * exported to the same output file as an earlier input file, since
+    * those files would be written concurrently.
+    */
+    bool checkOutputFilePaths(const FileExportTask &task) const;
+
+    static void printError(const QString &message);
+    static void printUsage(FILE *stream = stderr);
+};
+
+BatchExporter::BatchExporter()
+    : d_ptr(new BatchExporterPrivate())
+{
+    ;
+}
+
+BatchExporter::~BatchExporter()
+{
+    ;
+}
+
+bool BatchExporter::isRequested(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (QByteArray("--export") == argv[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int BatchExporter::exec(const QStringList &arguments)
+{
+    Q_D(BatchExporter);
+
+    QString err;
+
+    if (!d->parseArguments(arguments, err)) {
+        if (d->helpRequested) {
+            d->printUsage(stdout);
+            return Success;
+        }
+
+        if (!err.isEmpty()) {
+            d->printError(err);
+        }
+
+        d->printUsage();
+        return InvalidArguments;
+    }
+
+    Exporter *exporter = nullptr;
+    const ExportFormat *format = nullptr;
+
+    if (!d->findExporter(exporter, format, err)) {
+        d->printError(err);
+        return InvalidArguments;
+    }
+
+    if (!d->outputDir.isEmpty() && !QDir().mkpath(d->outputDir)) {
+        d->printError(QObject::tr("Could not create output folder %1")
+            .arg(d->outputDir));
+        return ExportFailed;
+    }
+
+    exporter->setSmartTypographyEnabled(d->smartTypographyEnabled);
+    exporter->setConcurrentExportsEnabled(true);
+
+    // Create the cmark-gfm API singleton before any worker threads
+    // can race to do so.
+    //
+    CmarkGfmAPI::instance();
+
+    FileExportTask task(exporter, format, d->outputDir);
+
+    if (!d->checkOutputFilePaths(task)) {
+        return InvalidArguments;
+    }
+
+    QStringList errors = QtConcurrent::blockingMapped(d->inputFiles, task);
+
+    int exitCode = Success;
+
+    for (int i = 0; i < errors.size(); i++) {
+        if (!errors[i].isNull()) {
+            d->printError(QString("%1: %2").arg(d->inputFiles[i]).arg(errors[i]));
+            exitCode = ExportFailed;
+        }
+    }
+
+    return exitCode;
+}
+
+QString FileExportTask::operator()(const QString &filePath) const
+{
+    QFile inputFile(filePath);
+
+    if (!inputFile.open(QIODevice::ReadOnly)) {
+        return inputFile.errorString();
+    }
+
+    QString text = QString::fromUtf8(inputFile.readAll());
+
+    if (QFile::NoError != inputFile.error()) {
+        return inputFile.errorString();
+    }
+
+    inputFile.close();
+
+    QFileInfo inputInfo(filePath);
+    QString outputFilePath = this->outputFilePath(filePath);
+
+    if (QFileInfo(outputFilePath) == inputInfo) {
+        return QObject::tr("Output file would overwrite the input file");
+    }
+
+    QString err;
+
+    exporter->exportToFile
+    (
+        format,
+        inputInfo.absoluteFilePath(),
+        text,
+        outputFilePath,
+        err
+    );
+
+    if (!err.isNull() && err.isEmpty()) {
+        err = QObject::tr("Export failed");
+    }
+
+    return err;
+}
+
+QString FileExportTask::outputFilePath(const QString &filePath) const
+{
+    QFileInfo inputInfo(filePath);
+    QDir dir = outputDir.isEmpty() ? inputInfo.absoluteDir() : QDir(outputDir);
+
+    return QDir::cleanPath
+        (
+            dir.absoluteFilePath
+            (
+                inputInfo.completeBaseName() + "." + format->defaultFileExtension()
+            )
+        );
+}
+
+bool BatchExporterPrivate::parseArguments(const QStringList &arguments, QString &err)
+{
+    for (int i = 1; i < arguments.size(); i++) {
+        const QString &arg = arguments.at(i);
+        bool hasValue = (i + 1) < arguments.size();
+
+        if ("--export" == arg) {
+            continue;
+        } else if (("-h" == arg) || ("--help" == arg)) {
+            helpRequested = true;
+            return false;
+        } else if ("--smart" == arg) {
+            smartTypographyEnabled = true;
+        } else if (("-f" == arg) || ("--format" == arg)) {
+            if (!hasValue) {
+                err = QObject::tr("Missing value for %1").arg(arg);
+                return false;
+            }
+
+            format = arguments.at(++i);
+        } else if (("-e" == arg) || ("--exporter" == arg)) {
+            if (!hasValue) {
+                err = QObject::tr("Missing value for %1").arg(arg);
+                return false;
+            }
+
+            exporterName = arguments.at(++i);
+        } else if (("-o" == arg) || ("--output" == arg)) {
+            if (!hasValue) {
+                err = QObject::tr("Missing value for %1").arg(arg);
+                return false;
+            }
+
+            outputDir = arguments.at(++i);
+        } else if (arg.startsWith('-') && (arg.length() > 1)) {
+            err = QObject::tr("Unknown option %1").arg(arg);
+            return false;
+        } else {
+            inputFiles.append(arg);
+        }
+    }
+
+    if (inputFiles.isEmpty()) {
+        err = QObject::tr("No input files given");
+        return false;
+    }
+
+    return true;
+}
+
+bool BatchExporterPrivate::findExporter
+(
+    Exporter *&exporter,
+    const ExportFormat *&format,
+    QString &err
+) const
+{
+    ExporterFactory *factory = ExporterFactory::instance();
+
+    if (!exporterName.isEmpty()) {
+        exporter = factory->exporterByName(exporterName);
+
+        if (nullptr == exporter) {
+            QStringList names;
+
+            foreach (Exporter *available, factory->fileExporters()) {
+                names.append(available->name());
+            }
+
+            err = QObject::tr("Unknown exporter %1.  Available exporters: %2")
+                  .arg(exporterName)
+                  .arg(names.join(", "));
+            return false;
+        }
+
+        format = findFormat(exporter);
+
+        if (nullptr == format) {
+            err = QObject::tr("%1 format is not supported by %2")
+                  .arg(this->format)
+                  .arg(exporterName);
+            return false;
+        }
+
+        return true;
+    }
+
+    // The built-in cmark-gfm exporter is always first in the list.
+    foreach (Exporter *available, factory->fileExporters()) {
+        format = findFormat(available);
+
+        if (nullptr != format) {
+            exporter = available;
+            return true;
+        }
+    }
+
+    err = QObject::tr("No available exporter supports the %1 format")
+          .arg(this->format);
+    return false;
+}
+
+const ExportFormat *BatchExporterPrivate::findFormat(const Exporter *exporter) const
+{
+    // Match the format name first, then fall back to the file extension
+    // so that, for example, "-f pdf" works as well as "-f 'PDF (LaTeX)'".
+    //
+    foreach (const ExportFormat *supported, exporter->supportedFormats()) {
+        if (0 == supported->name().compare(format, Qt::CaseInsensitive)) {
+            return supported;
+        }
+    }
+
+    foreach (const ExportFormat *supported, exporter->supportedFormats()) {
+        if (0 == supported->defaultFileExtension().compare(format, Qt::CaseInsensitive)) {
+            return supported;
+        }
+    }
+
+    return nullptr;
+}
+
+bool BatchExporterPrivate::checkOutputFilePaths(const FileExportTask &task) const
+{
+    QHash<QString, QString> inputFileByOutput;
+    bool valid = true;
+
+    foreach (const QString &inputFile, inputFiles) {
+        QString outputFilePath = task.outputFilePath(inputFile);
+        QString key = outputFilePath;
+
+#if defined(Q_OS_WIN) || defined(Q_OS_MAC)
+        // File names differing only in case name the same file on the
+        // default file systems of these platforms.
+        key = key.toLower();
+#endif
+
+        if (inputFileByOutput.contains(key)) {
+            printError(QObject::tr("%1: Output file %2 would also be written by %3")
+                .arg(inputFile)
+                .arg(QDir::toNativeSeparators(outputFilePath))
+                .arg(inputFileByOutput.value(key)));
+            valid = false;
+        } else {
+            inputFileByOutput.insert(key, inputFile);
+        }
+    }
+
+    return valid;
+}
+
+void BatchExporterPrivate::printError(const QString &message)
+{
+    fprintf(stderr, "%s: %s\n",
+        qUtf8Printable(QCoreApplication::applicationName()),
+        qUtf8Printable(message));
+}
+
+void BatchExporterPrivate::printUsage(FILE *stream)
+{
+    fprintf(stream, "%s\n", qUtf8Printable(QObject::tr(
+        "Usage: ghostwriter --export [options] <file>...\n"
+        "\n"
+        "Options:\n"
+        "  -f, --format <format>      Format name or file extension (default: html)\n"
+        "  -e, --exporter <name>      Exporter to use (default: cmark-gfm)\n"
+        "  -o, --output <folder>      Output folder (default: beside each input file)\n"
+        "  --smart                    Enable smart typography\n"
+        "  -h, --help                 Show this help")));
+}
+} // namespace ghostwriter
@@ -0,0 +1,85 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef BATCHEXPORTER_H
+#define BATCHEXPORTER_H
+
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+
+namespace ghostwriter
+{
+/**
+ * Exports Markdown files from the command line without creating any
+ * windows, for example:
+ *
+ *      ghostwriter --export -f html -o outdir/ *.md
+ *
+ * Files are converted in parallel using the same Exporters that are
+ * available from the Export dialog.  External processors run fully in
+ * parallel, whereas the built-in cmark-gfm exporter renders one file at a
+ * time, with only the reading and writing of files running in parallel.
+ * Errors are reported per file on the standard error stream.
+ */
+class BatchExporterPrivate;
+class BatchExporter
+{
+    Q_DECLARE_PRIVATE(BatchExporter)
+
+public:
+    /**
+     * Exit codes returned by exec().
+     */
+    enum ExitCode {
+        Success = 0,
+        ExportFailed = 1,
+        InvalidArguments = 2
+    };
+
+    /**
+     * Constructor.
+     */
+    BatchExporter();
+
+    /**
+     * Destructor.
+     */
+    ~BatchExporter();
+
+    /**
+     * Returns true if the given command line arguments request a headless
+     * export.  This can be called before any QCoreApplication exists.
+     */
+    static bool isRequested(int argc, char *argv[]);
+
+    /**
+     * Exports the files given in the command line arguments, blocking
+     * until all files have been exported.  Returns one of the ExitCode
+     * values.  If two input files would be exported to the same output
+     * file, nothing is exported and InvalidArguments is returned.
+     */
+    int exec(const QStringList &arguments);
+
+private:
+    QScopedPointer<BatchExporterPrivate> d_ptr;
+};
+} // namespace ghostwriter
+
+#endif // BATCHEXPORTER_H
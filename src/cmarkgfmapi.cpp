@@ -50,6 +50,18 @@ public:
     cmark_syntax_extension *tasklistExt;
 
     QMutex apiMutex;
+
+    /*
+    * Size of the chunks in which HTML is written out when rendering
+    * directly to a device.
+    */
+    static const size_t HTML_CHUNK_SIZE = 64 * 1024;
+
+    /*
+    * cmark-gfm write callback for rendering to a QIODevice, which is
+    * passed in as the user data.
+    */
+    static int writeToDevice(const char *data, size_t len, void *device);
 };
 
 CmarkGfmAPI *CmarkGfmAPIPrivate::instance = nullptr;
@@ -107,6 +119,11 @@ MarkdownAST *CmarkGfmAPI::parse(const QString &text, const bool smartTypographyE
 }
 
 QString CmarkGfmAPI::renderToHtml(const QString &text, const bool smartTypographyEnabled)
+{
+    return QString::fromUtf8(renderToHtmlUtf8(text, smartTypographyEnabled));
+}
+
+QByteArray CmarkGfmAPI::renderToHtmlUtf8(const QString &text, const bool smartTypographyEnabled)
 {
     Q_D(CmarkGfmAPI);
     
@@ -116,6 +133,8 @@ QString CmarkGfmAPI::renderToHtml(const QString &text, const bool smartTypograph
         opts |= CMARK_OPT_SMART;
     }
 
+    QByteArray utf8Text = text.toUtf8();
+
     d->apiMutex.lock();
 
     cmark_mem *mem = cmark_get_arena_mem_allocator();
@@ -127,11 +146,13 @@ QString CmarkGfmAPI::renderToHtml(const QString &text, const bool smartTypograph
     cmark_parser_attach_syntax_extension(parser, d->tagfilterExt);
     cmark_parser_attach_syntax_extension(parser, d->tasklistExt);
 
-    cmark_parser_feed(parser, text.toUtf8().data(), text.toUtf8().length());
+    cmark_parser_feed(parser, utf8Text.data(), utf8Text.length());
 
     cmark_node *root = cmark_parser_finish(parser);
     char *output = cmark_render_html(root, opts, cmark_parser_get_syntax_extensions(parser));
-    QString html = QString::fromUtf8(output);
+
+    // Copy the output before the arena it was allocated from is reset.
+    QByteArray html(output);
 
     cmark_parser_free(parser);
     cmark_arena_reset();
@@ -141,6 +162,62 @@ QString CmarkGfmAPI::renderToHtml(const QString &text, const bool smartTypograph
     return html;
 }
 
+bool CmarkGfmAPI::renderToHtml
+(
+    const QString &text,
+    QIODevice *device,
+    const bool smartTypographyEnabled
+)
+{
+    Q_D(CmarkGfmAPI);
+
+    int opts = CMARK_OPT_DEFAULT | CMARK_OPT_FOOTNOTES | CMARK_OPT_UNSAFE;
+
+    if (smartTypographyEnabled) {
+        opts |= CMARK_OPT_SMART;
+    }
+
+    QByteArray utf8Text = text.toUtf8();
+
+    d->apiMutex.lock();
+
+    cmark_mem *mem = cmark_get_arena_mem_allocator();
+    cmark_parser *parser = cmark_parser_new_with_mem(opts, mem);
+
+    cmark_parser_attach_syntax_extension(parser, d->tableExt);
+    cmark_parser_attach_syntax_extension(parser, d->strikethroughExt);
+    cmark_parser_attach_syntax_extension(parser, d->autolinkExt);
+    cmark_parser_attach_syntax_extension(parser, d->tagfilterExt);
+    cmark_parser_attach_syntax_extension(parser, d->tasklistExt);
+
+    cmark_parser_feed(parser, utf8Text.data(), utf8Text.length());
+
+    cmark_node *root = cmark_parser_finish(parser);
+    int err = cmark_render_html_to_writer
+        (
+            root,
+            opts,
+            cmark_parser_get_syntax_extensions(parser),
+            mem,
+            &CmarkGfmAPIPrivate::writeToDevice,
+            device,
+            CmarkGfmAPIPrivate::HTML_CHUNK_SIZE
+        );
+
+    cmark_parser_free(parser);
+    cmark_arena_reset();
+
+    d->apiMutex.unlock();
+
+    return (0 == err);
+}
+
+int CmarkGfmAPIPrivate::writeToDevice(const char *data, size_t len, void *device)
+{
+    qint64 written = static_cast<QIODevice *>(device)->write(data, len);
+    return (written == (qint64) len) ? 0 : 1;
+}
+
 CmarkGfmAPI::CmarkGfmAPI()
     : d_ptr(new CmarkGfmAPIPrivate())
 {
@@ -20,6 +20,7 @@
 #ifndef CMARK_PROCESSOR_H
 #define CMARK_PROCESSOR_H
 
+#include <QIODevice>
 #include <QScopedPointer>
 
 #include "markdownast.h"
@@ -58,6 +59,27 @@ public:
      */
     QString renderToHtml(const QString &text, const bool smartTypographyEnabled);
 
+    /**
+     * Returns HTML for the Markdown text encoded in UTF-8, as output by
+     * cmark-gfm.  Pass in true for smartTypographyEnabled to enable smart
+     * typography.
+     */
+    QByteArray renderToHtmlUtf8(const QString &text, const bool smartTypographyEnabled);
+
+    /**
+     * Renders HTML for the Markdown text directly to the given device,
+     * writing it out in UTF-8 chunks as it is rendered instead of holding
+     * the entire HTML document in memory.  Pass in true for
+     * smartTypographyEnabled to enable smart typography.  Returns false
+     * if writing to the device failed.
+     */
+    bool renderToHtml
+    (
+        const QString &text,
+        QIODevice *device,
+        const bool smartTypographyEnabled
+    );
+
 private:
     QScopedPointer<CmarkGfmAPIPrivate> d_ptr;
 
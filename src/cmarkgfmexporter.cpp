@@ -17,10 +17,9 @@
  *
  ***********************************************************************/
 
-#include <QFile>
 #include <QFileInfo>
 #include <QObject>
-#include <QTextStream>
+#include <QSaveFile>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -57,47 +56,65 @@ void CmarkGfmExporter::exportToFile
 {
     Q_UNUSED(inputFilePath);
 
-    QString html;
-
     if (ExportFormat::HTML != format) {
         err = QObject::tr("%1 format is unsupported by the cmark-gfm processor.")
               .arg(format->name());
         return;
     }
 
-    exportToHtml(text, html);
-
-    if (html.isNull()) {
-        err = QObject::tr("Export failed");
-        return;
-    }
-
-    QFile outputFile(outputFilePath);
+    QSaveFile outputFile(outputFilePath);
 
-    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    if (!outputFile.open(QIODevice::WriteOnly)) {
         err = outputFile.errorString();
         return;
     }
 
-    // Write contents to disk.
-    QTextStream outStream(&outputFile);
-
     // Specify the character set (UTF-8) for the HTML document.
     // Browsers typically can't tell if the HTML has unicode characters
     // unless UTF-8 is specified in the <head> section.
     //
-    outStream << "<html><head><meta http-equiv=\"Content-Type\" "
-              "content=\"text/html; charset=utf-8\" />"
-              "<title></title></head><body>";
+    outputFile.write("<html><head><meta http-equiv=\"Content-Type\" "
+                     "content=\"text/html; charset=utf-8\" />"
+                     "<title></title></head><body>");
+
+    bool rendered = true;
+
+    if (this->m_concurrentExportsEnabled) {
+        // cmark-gfm renders one document at a time, so render into memory
+        // and write the file afterwards, letting other exports render
+        // while this one is being written.
+        //
+        outputFile.write
+        (
+            CmarkGfmAPI::instance()->renderToHtmlUtf8
+            (
+                text,
+                this->m_smartTypographyEnabled
+            )
+        );
+    } else {
+        // Render straight to the file in UTF-8 so that the HTML for large
+        // documents is never held in memory all at once.
+        //
+        rendered = CmarkGfmAPI::instance()->renderToHtml
+            (
+                text,
+                &outputFile,
+                this->m_smartTypographyEnabled
+            );
+    }
 
-    outStream << html;
-    outStream << "</body></html>";
+    outputFile.write("</body></html>");
 
-    if (QFile::NoError != outputFile.error()) {
+    if (!rendered || (QFileDevice::NoError != outputFile.error())) {
         err = outputFile.errorString();
+        outputFile.cancelWriting();
+        return;
     }
 
-    // Close the file.  All done!
-    outputFile.close();
+    // Replace the file on disk.  All done!
+    if (!outputFile.commit()) {
+        err = outputFile.errorString();
+    }
 }
 }
@@ -18,12 +18,16 @@
  *
  ***********************************************************************/
 
-#include <QCommonStyle>
-#include <QDebug>
+#include <QAbstractTextDocumentLayout>
+#include <QCryptographicHash>
+#include <QFont>
+#include <QFontMetricsF>
 #include <QPainter>
+#include <QPalette>
 #include <QPixmap>
 #include <QStaticText>
-#include <QTextEdit>
+#include <QStringList>
+#include <QTextDocument>
 
 #include "colorschemepreviewer.h"
 #include "3rdparty/QtAwesome/QtAwesome.h"
@@ -36,10 +40,7 @@ class ColorSchemePreviewerPrivate
 public:
     ColorSchemePreviewerPrivate()
     {
-        if (nullptr == this->awesome) {
-            this->awesome = new QtAwesome();
-            this->awesome->initFontAwesome();
-        }
+        ;
     }
 
     ~ColorSchemePreviewerPrivate()
@@ -47,12 +48,19 @@ public:
         ;
     }
 
-    static QtAwesome *awesome;
+    static bool initialized;
+    static QFont symbolFont;
     QIcon thumbnailPreviewIcon;
     static const QString loremIpsum;
+
+    // Increment whenever the look of the rendered preview changes, so that
+    // thumbnails cached on disk by an older version are not reused.
+    //
+    static const int renderVersion = 1;
 };
 
-QtAwesome *ColorSchemePreviewerPrivate::awesome = nullptr;
+bool ColorSchemePreviewerPrivate::initialized = false;
+QFont ColorSchemePreviewerPrivate::symbolFont;
 
 const QString ColorSchemePreviewerPrivate::loremIpsum =
     "<p><h2><strong>"
@@ -87,10 +95,50 @@ ColorSchemePreviewer::ColorSchemePreviewer
     int height,
     qreal dpr
 ) : d_ptr(new ColorSchemePreviewerPrivate())
+{
+    Q_D(ColorSchemePreviewer);
+
+    initialize();
+
+    d->thumbnailPreviewIcon = QPixmap::fromImage
+        (
+            renderImage(colors, builtIn, valid, width, height, dpr)
+        );
+}
+
+ColorSchemePreviewer::~ColorSchemePreviewer()
+{
+    ;
+}
+
+QIcon ColorSchemePreviewer::icon()
 {
     Q_D(ColorSchemePreviewer);
     
-    QString text = d->loremIpsum;
+    return d->thumbnailPreviewIcon;
+}
+
+void ColorSchemePreviewer::initialize()
+{
+    if (!ColorSchemePreviewerPrivate::initialized) {
+        QFont font(QtAwesome::instance()->font(style::stfas, 16));
+        font.setPixelSize(22);
+        ColorSchemePreviewerPrivate::symbolFont = font;
+        ColorSchemePreviewerPrivate::initialized = true;
+    }
+}
+
+QImage ColorSchemePreviewer::renderImage
+(
+    const ColorScheme &colors,
+    bool builtIn,
+    bool valid,
+    int width,
+    int height,
+    qreal dpr
+)
+{
+    QString text = ColorSchemePreviewerPrivate::loremIpsum;
 
     text.replace("@headingMarkup", colors.headingMarkup.name());
     text.replace("@headingText", colors.headingText.name());
@@ -100,31 +148,34 @@ ColorSchemePreviewer::ColorSchemePreviewer
     text.replace("@codeMarkup", colors.codeMarkup.name());
     text.replace("@codeText", colors.codeText.name());
 
-    QTextEdit textEdit;
-    textEdit.setHtml(text);
-    textEdit.setFrameStyle(QFrame::NoFrame);
-    textEdit.setAutoFillBackground(false);
-    textEdit.setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    textEdit.setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    textEdit.setFixedSize(width, height);
-    textEdit.setStyle(new QCommonStyle());
-    textEdit.setStyleSheet
-    (
-        "QTextEdit { color: "
-        + colors.foreground.name()
-        + "; background-color: "
-        + colors.background.name()
-        + "; font-family: Roboto Mono, monospace; font-size: 20px }"
-    );
-
-    QPixmap thumbnailPixmap(width * dpr, height * dpr);
-    thumbnailPixmap.setDevicePixelRatio(dpr);
-    QPainter painter(&thumbnailPixmap);
-    painter.fillRect(thumbnailPixmap.rect(), colors.background);
-    painter.setRenderHints(QPainter::Antialiasing);
-    textEdit.render(&painter);
-
-    if (!valid || builtIn) {
+    // Lay out the text with a bare QTextDocument rather than a QTextEdit,
+    // since widgets may only be created on the GUI thread.  The font and
+    // margin match what the text edit used to be styled with.
+    //
+    QFont font("Roboto Mono");
+    font.setStyleHint(QFont::Monospace);
+    font.setPixelSize(20);
+
+    QTextDocument document;
+    document.setDefaultFont(font);
+    document.setDocumentMargin(4);
+    document.setHtml(text);
+    document.setTextWidth(width);
+
+    QImage thumbnail(width * dpr, height * dpr, QImage::Format_ARGB32_Premultiplied);
+    thumbnail.setDevicePixelRatio(dpr);
+    thumbnail.fill(colors.background);
+
+    QPainter painter(&thumbnail);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    painter.setClipRect(QRect(0, 0, width, height));
+
+    QAbstractTextDocumentLayout::PaintContext context;
+    context.palette.setColor(QPalette::Text, colors.foreground);
+    context.clip = QRectF(0, 0, width, height);
+    document.documentLayout()->draw(&painter, context);
+
+    if ((!valid || builtIn) && ColorSchemePreviewerPrivate::initialized) {
         QString symbol = QChar(fa::lock);
         QColor color = colors.foreground;
 
@@ -133,32 +184,53 @@ ColorSchemePreviewer::ColorSchemePreviewer
             color = colors.error;
         }
 
-        QFont font(d->awesome->font(style::stfas, 16));
-        font.setPixelSize(22);
-
-        QFontMetricsF metrics(font);
+        QFontMetricsF metrics(ColorSchemePreviewerPrivate::symbolFont);
         int x = width - metrics.width(symbol) - 2;
         int y = 2;
 
-        painter.setFont(font);
+        painter.setFont(ColorSchemePreviewerPrivate::symbolFont);
         painter.setBrush(Qt::NoBrush);
         painter.setPen(color);
         painter.drawStaticText(x, y, QStaticText(symbol));
     }
 
     painter.end();
-    d->thumbnailPreviewIcon = thumbnailPixmap;
-}
-
-ColorSchemePreviewer::~ColorSchemePreviewer()
-{
-    ;
+    return thumbnail;
 }
 
-QIcon ColorSchemePreviewer::icon()
+QByteArray ColorSchemePreviewer::cacheKey
+(
+    const ColorScheme &colors,
+    bool builtIn,
+    bool valid,
+    int width,
+    int height,
+    qreal dpr
+)
 {
-    Q_D(ColorSchemePreviewer);
-    
-    return d->thumbnailPreviewIcon;
+    QStringList fields;
+
+    fields << QString::number(ColorSchemePreviewerPrivate::renderVersion)
+        << QString::number(builtIn)
+        << QString::number(valid)
+        << QString::number(width)
+        << QString::number(height)
+        << QString::number(dpr)
+        << colors.foreground.name()
+        << colors.background.name()
+        << colors.error.name()
+        << colors.headingMarkup.name()
+        << colors.headingText.name()
+        << colors.emphasisMarkup.name()
+        << colors.emphasisText.name()
+        << colors.link.name()
+        << colors.codeMarkup.name()
+        << colors.codeText.name();
+
+    return QCryptographicHash::hash
+        (
+            fields.join(',').toUtf8(),
+            QCryptographicHash::Sha1
+        ).toHex();
 }
 } // namespace ghostwriter
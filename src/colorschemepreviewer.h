@@ -20,7 +20,9 @@
 #ifndef COLOR_SCHEME_PREVIEWER_H
 #define COLOR_SCHEME_PREVIEWER_H
 
+#include <QByteArray>
 #include <QIcon>
+#include <QImage>
 #include <QScopedPointer>
 
 #include "colorscheme.h"
@@ -63,6 +65,44 @@ public:
      */
     QIcon icon();
 
+    /**
+     * Prepares the resources shared by all previews.  Must be called from
+     * the GUI thread before renderImage() is called from any other thread.
+     * Constructing a ColorSchemePreviewer calls this implicitly.
+     */
+    static void initialize();
+
+    /**
+     * Renders the thumbnail preview to an image without the use of any
+     * widgets, so that it is safe to call from a worker thread once
+     * initialize() has been called.  The returned image has the given
+     * device pixel ratio set.
+     */
+    static QImage renderImage
+    (
+        const ColorScheme &colors,
+        bool builtIn,
+        bool valid,
+        int width,
+        int height,
+        qreal dpr = 1.0
+    );
+
+    /**
+     * Returns a key that uniquely identifies the image renderImage() would
+     * produce for the given parameters, suitable for naming a cached copy
+     * of the thumbnail on disk.
+     */
+    static QByteArray cacheKey
+    (
+        const ColorScheme &colors,
+        bool builtIn,
+        bool valid,
+        int width,
+        int height,
+        qreal dpr = 1.0
+    );
+
 private:
     QScopedPointer<ColorSchemePreviewerPrivate> d_ptr;
 
@@ -17,11 +17,14 @@
  *
  ***********************************************************************/
 
-#include <QString>
-#include <QStringList>
-#include <QList>
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QFileInfo>
+#include <QList>
 #include <QSettings>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
 
 #include "documenthistory.h"
 
@@ -30,6 +33,16 @@
 #define FILE_PATH_KEY "filePath"
 #define CURSOR_POSITION_KEY "cursorPosition"
 
+// Delay in milliseconds before pending history changes are written to
+// QSettings.  Multiple changes within this window are coalesced into a
+// single write.
+#define FLUSH_DELAY_MS 2000
+
+// Time in milliseconds for which a recent file is trusted to still exist
+// after its existence was last checked.  Files deleted or moved while the
+// application is running drop out of the history once this expires.
+#define EXISTENCE_CHECK_INTERVAL_MS 5000
+
 namespace ghostwriter
 {
 /*
@@ -41,6 +54,12 @@ public:
     QString filePath;
     int position;
 
+    // Time, according to DocumentHistoryIndex::now(), at which the file
+    // was last confirmed to exist on disk, or -1 if it has not been.
+    // Existence is checked lazily, only for entries that are actually
+    // requested.
+    qint64 existenceCheckedAt;
+
     inline bool operator==(const RecentFile &other)
     {
         return (other.filePath == filePath);
@@ -49,8 +68,39 @@ public:
 
 typedef QList<RecentFile> RecentFilesList;
 
-RecentFilesList loadFromSettings(int max = -1);
-void storeToSettings(const RecentFilesList &recentFiles);
+/*
+* Process-wide, in-memory index of the file history.  The history is read
+* from QSettings only once, and changes are written back on a deferred
+* timer so that opening and closing files never waits on settings I/O.
+*/
+class DocumentHistoryIndex
+{
+public:
+    static DocumentHistoryIndex *instance();
+
+    RecentFilesList &files();
+
+    /*
+    * Returns the number of milliseconds since the index was created.
+    */
+    qint64 now() const;
+
+    void markDirty();
+    void flush();
+
+private:
+    DocumentHistoryIndex();
+
+    void loadFromSettings();
+    void storeToSettings();
+
+    RecentFilesList recentFiles;
+    bool loaded;
+    bool dirty;
+    QTimer *flushTimer;
+    QElapsedTimer clock;
+};
+
 void cleanUpHistory(RecentFilesList &recentFiles);
 
 
@@ -66,11 +116,33 @@ DocumentHistory::~DocumentHistory()
 
 QStringList DocumentHistory::recentFiles(int max)
 {
-    RecentFilesList recentFiles = loadFromSettings(max);
+    DocumentHistoryIndex *index = DocumentHistoryIndex::instance();
+    RecentFilesList &recentFiles = index->files();
     QStringList filePathList;
 
-    for (int i = 0; i < recentFiles.size(); i++) {
-        filePathList.append(recentFiles.at(i).filePath);
+    if (max < 0) {
+        max = recentFiles.size();
+    }
+
+    int i = 0;
+    qint64 now = index->now();
+
+    while ((i < recentFiles.size()) && (filePathList.size() < max)) {
+        RecentFile &file = recentFiles[i];
+
+        if ((file.existenceCheckedAt < 0)
+                || ((now - file.existenceCheckedAt) > EXISTENCE_CHECK_INTERVAL_MS)) {
+            if (QFileInfo::exists(file.filePath)) {
+                file.existenceCheckedAt = now;
+            } else {
+                recentFiles.removeAt(i);
+                index->markDirty();
+                continue;
+            }
+        }
+
+        filePathList.append(file.filePath);
+        i++;
     }
 
     return filePathList;
@@ -86,15 +158,17 @@ void DocumentHistory::add
 
     if (fileInfo.exists()) {
         QString sanitizedPath = fileInfo.canonicalFilePath();
-        RecentFilesList recentFiles = loadFromSettings();
+        DocumentHistoryIndex *index = DocumentHistoryIndex::instance();
+        RecentFilesList &recentFiles = index->files();
         RecentFile lastFile;
 
         lastFile.filePath = sanitizedPath;
         lastFile.position = cursorPosition;
+        lastFile.existenceCheckedAt = index->now();
         recentFiles.removeAll(lastFile);
         recentFiles.prepend(lastFile);
         cleanUpHistory(recentFiles);
-        storeToSettings(recentFiles);
+        index->markDirty();
     }
 }
 
@@ -103,10 +177,7 @@ int DocumentHistory::cursorPosition(const QString &filePath)
     QString sanitizedPath = QFileInfo(filePath).canonicalFilePath();
     int position = 0;
 
-    RecentFilesList recentFiles = loadFromSettings();
-    cleanUpHistory(recentFiles);
-
-    foreach (RecentFile file, recentFiles) {
+    foreach (const RecentFile &file, DocumentHistoryIndex::instance()->files()) {
         if (sanitizedPath == file.filePath) {
             position = file.position;
             break;
@@ -122,47 +193,114 @@ int DocumentHistory::cursorPosition(const QString &filePath)
 
 void DocumentHistory::clear()
 {
-    QSettings settings;
-    settings.remove(FILE_HISTORY_KEY);
+    DocumentHistoryIndex *index = DocumentHistoryIndex::instance();
+
+    index->files().clear();
+    index->markDirty();
 }
 
-RecentFilesList loadFromSettings(int max)
+DocumentHistoryIndex *DocumentHistoryIndex::instance()
 {
-    QSettings settings;
-    int size = settings.beginReadArray(FILE_HISTORY_KEY);
+    static DocumentHistoryIndex *index = nullptr;
 
-    RecentFilesList recentFiles;
+    if (nullptr == index) {
+        index = new DocumentHistoryIndex();
+    }
 
-    if (max < 0) {
-        max = size;
+    return index;
+}
+
+DocumentHistoryIndex::DocumentHistoryIndex()
+    : loaded(false), dirty(false)
+{
+    flushTimer = new QTimer();
+    flushTimer->setSingleShot(true);
+    flushTimer->setInterval(FLUSH_DELAY_MS);
+    clock.start();
+
+    QObject::connect
+    (
+        flushTimer,
+        &QTimer::timeout,
+        [this]() {
+            this->flush();
+        }
+    );
+
+    // Make sure pending changes are not lost on exit.
+    if (nullptr != QCoreApplication::instance()) {
+        QObject::connect
+        (
+            QCoreApplication::instance(),
+            &QCoreApplication::aboutToQuit,
+            [this]() {
+                this->flush();
+            }
+        );
+    }
+}
+
+RecentFilesList &DocumentHistoryIndex::files()
+{
+    if (!loaded) {
+        loadFromSettings();
+        loaded = true;
     }
 
-    int filesAdded = 0;
+    return recentFiles;
+}
 
-    for (int i = 0; (i < size) && (filesAdded < max); i++) {
+qint64 DocumentHistoryIndex::now() const
+{
+    return clock.elapsed();
+}
+
+void DocumentHistoryIndex::markDirty()
+{
+    dirty = true;
+    flushTimer->start();
+}
+
+void DocumentHistoryIndex::flush()
+{
+    flushTimer->stop();
+
+    if (dirty) {
+        storeToSettings();
+        dirty = false;
+    }
+}
+
+void DocumentHistoryIndex::loadFromSettings()
+{
+    QSettings settings;
+    int size = settings.beginReadArray(FILE_HISTORY_KEY);
+
+    recentFiles.clear();
+
+    for (int i = 0; i < size; i++) {
         settings.setArrayIndex(i);
 
         QString filePath = settings.value(FILE_PATH_KEY).toString();
         int position = settings.value(CURSOR_POSITION_KEY, 0).toInt();
 
-        if (!filePath.isNull() && !filePath.isEmpty() && QFileInfo(filePath).exists()) {
+        // Existence of the file is not checked here, since doing so for
+        // every entry is slow on network drives.  It is instead verified
+        // lazily when the entry is first requested.
+        if (!filePath.isNull() && !filePath.isEmpty()) {
             RecentFile recentFile;
             recentFile.filePath = filePath;
             recentFile.position = position;
+            recentFile.existenceCheckedAt = -1;
             recentFiles.append(recentFile);
-            filesAdded++;
         }
     }
 
     settings.endArray();
-
-    return recentFiles;
+    cleanUpHistory(recentFiles);
 }
 
-void storeToSettings
-(
-    const RecentFilesList &recentFiles
-)
+void DocumentHistoryIndex::storeToSettings()
 {
     QSettings settings;
 
@@ -174,7 +312,7 @@ void storeToSettings
     settings.beginWriteArray(FILE_HISTORY_KEY, recentFiles.size());
 
     for (int i = 0; i < recentFiles.size(); i++) {
-        RecentFile recentFile = recentFiles.at(i);
+        const RecentFile &recentFile = recentFiles.at(i);
 
         settings.setArrayIndex(i);
         settings.setValue(FILE_PATH_KEY, recentFile.filePath);
@@ -29,8 +29,12 @@ namespace ghostwriter
 {
 /**
  * This class stores and retrieves recent file history using QSettings.
- * It is reentrant, and different instances can be used from anywhere to
- * access the same file history.
+ * Different instances can be used from anywhere on the GUI thread to
+ * access the same file history.  All instances share a single in-memory
+ * index that is loaded once and is not synchronized, so this class must
+ * only be used from the GUI thread.  Changes are written back to
+ * QSettings after a short delay so that callers never block on settings
+ * I/O.
  */
 class DocumentHistory
 {
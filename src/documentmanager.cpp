@@ -44,6 +44,7 @@
 #include "markdowneditor.h"
 #include "messageboxhelper.h"
 #include "themerepository.h"
+#include "trace.h"
 
 namespace ghostwriter
 {
@@ -181,11 +182,20 @@ public:
 };
 
 const QString DocumentManagerPrivate::FILE_CHOOSER_FILTER =
-    QString("%1 (*.md *.markdown *.mdown *.mkdn *.mkd *.mdwn *.mdtxt *.mdtext *.text *.Rmd *.txt);;%2 (*.txt);;%3 (*)")
+    QString("%1 (%2);;%3 (*.txt);;%4 (*)")
     .arg(QObject::tr("Markdown"))
+    .arg(DocumentManager::markdownFileNameFilters().join(' '))
     .arg(QObject::tr("Text"))
     .arg(QObject::tr("All"));
 
+QStringList DocumentManager::markdownFileNameFilters()
+{
+    return QStringList()
+        << "*.md" << "*.markdown" << "*.mdown" << "*.mkdn" << "*.mkd"
+        << "*.mdwn" << "*.mdtxt" << "*.mdtext" << "*.text" << "*.Rmd"
+        << "*.txt";
+}
+
 DocumentManager::DocumentManager
 (
     MarkdownEditor *editor,
@@ -704,6 +714,7 @@ void DocumentManagerPrivate::saveFile()
 bool DocumentManagerPrivate::loadFile(const QString &filePath)
 {
     Q_Q(DocumentManager);
+    GW_TRACE_SCOPE("loadFile", "io");
 
     QFileInfo fileInfo(filePath);
     QFile inputFile(filePath);
@@ -919,6 +930,7 @@ QString DocumentManagerPrivate::saveToDisk
     bool createBackup
 ) const
 {
+    GW_TRACE_SCOPE("saveToDisk", "io");
     QString err;
 
     if (filePath.isNull() || filePath.isEmpty()) {
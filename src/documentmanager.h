@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QScopedPointer>
+#include <QStringList>
 
 #include "markdowndocument.h"
 #include "markdowneditor.h"
@@ -56,6 +57,12 @@ public:
      */
     virtual ~DocumentManager();
 
+    /**
+     * Gets the file name filters (i.e., "*.md") of the file types
+     * recognized as Markdown documents.
+     */
+    static QStringList markdownFileNameFilters();
+
     /**
      * Gets the current document that is opened.
      */
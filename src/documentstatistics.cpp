@@ -21,9 +21,43 @@
 #include <QTextBoundaryFinder>
 
 #include "documentstatistics.h"
+#include "taskscheduler.h"
+#include "trace.h"
 
 namespace ghostwriter
 {
+DocumentStatisticsSnapshot::DocumentStatisticsSnapshot()
+    : wordCount(0),
+      characterCount(0),
+      sentenceCount(0),
+      paragraphCount(0),
+      pageCount(0),
+      complexWords(0),
+      readingTime(0),
+      lixReadingEase(0),
+      readabilityIndex(0)
+{
+    ;
+}
+
+bool DocumentStatisticsSnapshot::operator==(const DocumentStatisticsSnapshot &other) const
+{
+    return (wordCount == other.wordCount)
+        && (characterCount == other.characterCount)
+        && (sentenceCount == other.sentenceCount)
+        && (paragraphCount == other.paragraphCount)
+        && (pageCount == other.pageCount)
+        && (complexWords == other.complexWords)
+        && (readingTime == other.readingTime)
+        && (lixReadingEase == other.lixReadingEase)
+        && (readabilityIndex == other.readabilityIndex);
+}
+
+bool DocumentStatisticsSnapshot::operator!=(const DocumentStatisticsSnapshot &other) const
+{
+    return !(*this == other);
+}
+
 class DocumentStatisticsPrivate
 {
     Q_DECLARE_PUBLIC(DocumentStatistics)
@@ -63,7 +97,36 @@ public:
     int lixLongWordCount;
     int readTimeMinutes;
 
+    // Statistics last emitted with statisticsChanged().
+    DocumentStatisticsSnapshot snapshot;
+
+    // Incremental recount of the document, run by the TaskScheduler.
+    int recountJob;
+    bool recountInProgress;
+    QTextBlock recountBlock;
+    int recountWordCount;
+    int recountWordCharacterCount;
+    int recountSentenceCount;
+    int recountParagraphCount;
+    int recountLixLongWordCount;
+
+    /*
+    * Recounts the document's blocks, starting where the last call left off.
+    * Returns true when the entire document has been counted and the
+    * statistics have been updated, or false if the scheduler's time
+    * budget ran out first.  Pass in false for canYield to count the rest
+    * of the document regardless of the time budget.
+    */
+    bool recount(bool canYield = true);
+
     void updateStatistics();
+
+    /*
+    * Emits the given statistics, unless they are the same as the
+    * statistics that were last emitted.
+    */
+    void publish(const DocumentStatisticsSnapshot &statistics);
+
     void updateBlockStatistics(QTextBlock &block);
     void countWords
     (
@@ -94,11 +157,22 @@ DocumentStatistics::DocumentStatistics(MarkdownDocument *document, QObject *pare
     d->pageCount = 0;
     d->lixLongWordCount = 0;
     d->readTimeMinutes = 0;
+    d->recountInProgress = false;
+    d->recountJob = TaskScheduler::instance()->addJob
+        (
+            this,
+            TaskScheduler::SidebarPriority,
+            [d]() {
+                return d->recount();
+            }
+        );
 
     connect(d->document, SIGNAL(contentsChange(int, int, int)), this, SLOT(onTextChanged(int, int, int)));
     connect(d->document,
         &MarkdownDocument::cleared,
         [d]() {
+            TaskScheduler::instance()->cancel(d->recountJob);
+            d->recountInProgress = false;
             d->wordCount = 0;
             d->wordCharacterCount = 0;
             d->sentenceCount = 0;
@@ -157,6 +231,21 @@ int DocumentStatistics::readingTime() const
     return d->readTimeMinutes;
 }
 
+DocumentStatisticsSnapshot DocumentStatistics::statistics() const
+{
+    Q_D(const DocumentStatistics);
+
+    return d->snapshot;
+}
+
+void DocumentStatistics::finishRecount()
+{
+    Q_D(DocumentStatistics);
+
+    TaskScheduler::instance()->cancel(d->recountJob);
+    d->recount(false);
+}
+
 void DocumentStatistics::onTextSelected
 (
     const QString &selectedText,
@@ -196,15 +285,19 @@ void DocumentStatistics::onTextSelected
         block = block.next();
     }
 
-    emit wordCountChanged(selectionWordCount);
-    emit characterCountChanged(selectedText.length());
-    emit sentenceCountChanged(selectionSentenceCount);
-    emit paragraphCountChanged(selectedParagraphCount);
-    emit pageCountChanged(d->calculatePageCount(selectionWordCount));
-    emit complexWordsChanged(d->calculateComplexWords(selectionWordCount, selectionLixLongWordCount));
-    emit readingTimeChanged(d->calculateReadingTime(selectionWordCount));
-    emit lixReadingEaseChanged(d->calculateLIX(selectionWordCount, selectionLixLongWordCount, selectionSentenceCount));
-    emit readabilityIndexChanged(d->calculateCLI(selectionWordCharacterCount, selectionWordCount, selectionSentenceCount));
+    DocumentStatisticsSnapshot statistics;
+
+    statistics.wordCount = selectionWordCount;
+    statistics.characterCount = selectedText.length();
+    statistics.sentenceCount = selectionSentenceCount;
+    statistics.paragraphCount = selectedParagraphCount;
+    statistics.pageCount = d->calculatePageCount(selectionWordCount);
+    statistics.complexWords = d->calculateComplexWords(selectionWordCount, selectionLixLongWordCount);
+    statistics.readingTime = d->calculateReadingTime(selectionWordCount);
+    statistics.lixReadingEase = d->calculateLIX(selectionWordCount, selectionLixLongWordCount, selectionSentenceCount);
+    statistics.readabilityIndex = d->calculateCLI(selectionWordCharacterCount, selectionWordCount, selectionSentenceCount);
+
+    d->publish(statistics);
 }
 
 void DocumentStatistics::onTextDeselected()
@@ -217,33 +310,55 @@ void DocumentStatistics::onTextDeselected()
 void DocumentStatistics::onTextChanged(int position, int charsRemoved, int charsAdded)
 {
     Q_D(DocumentStatistics);
+    GW_TRACE_SCOPE("DocumentStatistics::onTextChanged", "statistics");
 
     Q_UNUSED(position)
     Q_UNUSED(charsRemoved)
     Q_UNUSED(charsAdded)
 
-    d->wordCount = 0;
-    d->wordCharacterCount = 0;
-    d->sentenceCount = 0;
-    d->paragraphCount = 0;
-    d->pageCount = 0;
-    d->lixLongWordCount = 0;
-    d->readTimeMinutes = 0;
-
-    // Update the word counts of affected blocks.
+    // Restart the recount from the top of the document, since the blocks
+    // it was working through may no longer exist.  Blocks whose text did
+    // not change keep their counts, so only the edited blocks are
+    // actually recounted.
     //
-    QTextBlock startBlock = d->document->firstBlock();
-    QTextBlock endBlock = d->document->lastBlock();
-    QTextBlock block = startBlock;
+    d->recountInProgress = false;
+    TaskScheduler::instance()->schedule(d->recountJob);
+}
 
-    d->updateBlockStatistics(block);
+bool DocumentStatisticsPrivate::recount(bool canYield)
+{
+    GW_TRACE_SCOPE("DocumentStatistics::recount", "statistics");
+
+    TaskScheduler *scheduler = TaskScheduler::instance();
+
+    if (!recountInProgress) {
+        recountInProgress = true;
+        recountBlock = document->firstBlock();
+        recountWordCount = 0;
+        recountWordCharacterCount = 0;
+        recountSentenceCount = 0;
+        recountParagraphCount = 0;
+        recountLixLongWordCount = 0;
+    }
 
-    while (block != endBlock) {
-        block = block.next();
-        d->updateBlockStatistics(block);
+    while (recountBlock.isValid()) {
+        updateBlockStatistics(recountBlock);
+        recountBlock = recountBlock.next();
+
+        if (canYield && recountBlock.isValid() && scheduler->shouldYield()) {
+            return false;
+        }
     }
 
-    d->updateStatistics();
+    recountInProgress = false;
+    wordCount = recountWordCount;
+    wordCharacterCount = recountWordCharacterCount;
+    sentenceCount = recountSentenceCount;
+    paragraphCount = recountParagraphCount;
+    lixLongWordCount = recountLixLongWordCount;
+    updateStatistics();
+
+    return true;
 }
 
 void DocumentStatisticsPrivate::updateStatistics()
@@ -252,17 +367,35 @@ void DocumentStatisticsPrivate::updateStatistics()
 
     this->pageCount = calculatePageCount(wordCount);
     this->readTimeMinutes = calculateReadingTime(wordCount);
-    
-    emit q->wordCountChanged(wordCount);
-    emit q->totalWordCountChanged(wordCount);
-    emit q->characterCountChanged(document->characterCount() - 1);
-    emit q->sentenceCountChanged(sentenceCount);
-    emit q->paragraphCountChanged(paragraphCount);
-    emit q->pageCountChanged(pageCount);
-    emit q->complexWordsChanged(calculateComplexWords(wordCount, lixLongWordCount));
-    emit q->readingTimeChanged(this->readTimeMinutes);
-    emit q->lixReadingEaseChanged(calculateLIX(wordCount, lixLongWordCount, sentenceCount));
-    emit q->readabilityIndexChanged(calculateCLI(wordCharacterCount, wordCount, sentenceCount));
+
+    DocumentStatisticsSnapshot statistics;
+
+    statistics.wordCount = wordCount;
+    statistics.characterCount = document->characterCount() - 1;
+    statistics.sentenceCount = sentenceCount;
+    statistics.paragraphCount = paragraphCount;
+    statistics.pageCount = pageCount;
+    statistics.complexWords = calculateComplexWords(wordCount, lixLongWordCount);
+    statistics.readingTime = this->readTimeMinutes;
+    statistics.lixReadingEase = calculateLIX(wordCount, lixLongWordCount, sentenceCount);
+    statistics.readabilityIndex = calculateCLI(wordCharacterCount, wordCount, sentenceCount);
+
+    publish(statistics);
+
+    if (wordCount != totalWordCount) {
+        totalWordCount = wordCount;
+        emit q->totalWordCountChanged(totalWordCount);
+    }
+}
+
+void DocumentStatisticsPrivate::publish(const DocumentStatisticsSnapshot &statistics)
+{
+    Q_Q(DocumentStatistics);
+
+    if (statistics != snapshot) {
+        snapshot = statistics;
+        emit q->statisticsChanged(snapshot);
+    }
 }
 
 void DocumentStatisticsPrivate::updateBlockStatistics(QTextBlock &block)
@@ -274,23 +407,40 @@ void DocumentStatisticsPrivate::updateBlockStatistics(QTextBlock &block)
         block.setUserData(blockData);
     }
 
-    countWords
-    (
-        block.text(),
-        blockData->wordCount,
-        blockData->lixLongWordCount,
-        blockData->alphaNumericCharacterCount
-    );
+    // Only fetch the text of blocks that changed since they were last
+    // counted, since QTextBlock::text() builds a new string every time.
+    //
+    if (blockData->statisticsRevision != block.revision()) {
+        QString text = block.text();
+
+        countWords
+        (
+            text,
+            blockData->wordCount,
+            blockData->lixLongWordCount,
+            blockData->alphaNumericCharacterCount
+        );
+
+        blockData->sentenceCount = countSentences(text);
+        blockData->blank = true;
+
+        for (int i = 0; i < text.length(); i++) {
+            if (!text[i].isSpace()) {
+                blockData->blank = false;
+                break;
+            }
+        }
 
-    wordCount += blockData->wordCount;
-    lixLongWordCount += blockData->lixLongWordCount;
-    wordCharacterCount += blockData->alphaNumericCharacterCount;
+        blockData->statisticsRevision = block.revision();
+    }
 
-    blockData->sentenceCount = countSentences(block.text());
-    sentenceCount += blockData->sentenceCount;
+    recountWordCount += blockData->wordCount;
+    recountLixLongWordCount += blockData->lixLongWordCount;
+    recountWordCharacterCount += blockData->alphaNumericCharacterCount;
+    recountSentenceCount += blockData->sentenceCount;
 
-    if (block.text().trimmed().length() > 0) {
-        paragraphCount++;
+    if (!blockData->blank) {
+        recountParagraphCount++;
     }
 }
 
@@ -28,6 +28,39 @@
 
 namespace ghostwriter
 {
+/**
+ * Value type holding a complete set of document statistics, either for the
+ * entire document or for the selected text.
+ */
+struct DocumentStatisticsSnapshot
+{
+    /**
+     * Constructor.  All statistics are initialized to zero.
+     */
+    DocumentStatisticsSnapshot();
+
+    bool operator==(const DocumentStatisticsSnapshot &other) const;
+    bool operator!=(const DocumentStatisticsSnapshot &other) const;
+
+    int wordCount;
+    int characterCount;
+    int sentenceCount;
+    int paragraphCount;
+    int pageCount;
+
+    // Percentage of words that are complex (long) words.
+    int complexWords;
+
+    // Reading time in minutes.
+    int readingTime;
+
+    // LIX reading ease.
+    int lixReadingEase;
+
+    // Coleman-Liau readability index (CLI).
+    int readabilityIndex;
+};
+
 /**
  * Class to compute document statistics for a QTextDocument.
  */
@@ -63,58 +96,31 @@ public:
 
     int readingTime() const;
 
-signals:
-    /**
-     * Emitted when word count changes.  May be word count
-     * of entire document or of selected text.
-     */
-    void wordCountChanged(int value);
-
-    /**
-     * Emitted when word count changes.  The value is
-     * always the word count of the entire document.
-     */
-    void totalWordCountChanged(int value);
-
-    /**
-     * Emitted when character count changes.
-     */
-    void characterCountChanged(int value);
-
-    /**
-     * Emitted when paragraph count changes.
-     */
-    void paragraphCountChanged(int value);
-
-    /**
-     * Emitted when sentence count changes.
-     */
-    void sentenceCountChanged(int value);
-
-    /**
-     * Emitted when page count changes.
-     */
-    void pageCountChanged(int value);
-
     /**
-     * Emitted when complex word percentage changes.
+     * Gets the statistics most recently emitted with statisticsChanged().
      */
-    void complexWordsChanged(int percentage);
+    DocumentStatisticsSnapshot statistics() const;
 
     /**
-     * Emitted when reading time changes.
+     * Finishes counting the document immediately, rather than over the
+     * next few passes of the TaskScheduler, so that the statistics are up
+     * to date.  Call this before reading wordCount() right after the whole
+     * document has been replaced, such as when a file is opened.
      */
-    void readingTimeChanged(int minutes);
+    void finishRecount();
 
+signals:
     /**
-     * Emitted when LIX reading ease value changes.
+     * Emitted once whenever any of the statistics change.  The statistics
+     * may be for the entire document or for the selected text.
      */
-    void lixReadingEaseChanged(int value);
+    void statisticsChanged(const DocumentStatisticsSnapshot &statistics);
 
     /**
-     * Emitted when Coleman-Liau readability index (CLI) changes.
+     * Emitted when word count changes.  The value is
+     * always the word count of the entire document.
      */
-    void readabilityIndexChanged(int value);
+    void totalWordCountChanged(int value);
 
 public slots:
     /**
@@ -143,4 +149,6 @@ private:
 
 } //namespace ghostwriter
 
+Q_DECLARE_METATYPE(ghostwriter::DocumentStatisticsSnapshot)
+
 #endif // DOCUMENTSTATISTICS_H
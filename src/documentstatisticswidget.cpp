@@ -62,6 +62,12 @@ public:
 
     // Coleman-Liau readability index (CLI)
     QLabel *cliLabel;
+
+    // Statistics currently displayed.
+    DocumentStatisticsSnapshot statistics;
+
+    QString readingEaseText(int value) const;
+    static QString readabilityIndexText(int value);
 };
 
 DocumentStatisticsWidget::DocumentStatisticsWidget(QWidget *parent)
@@ -80,6 +86,8 @@ DocumentStatisticsWidget::DocumentStatisticsWidget(QWidget *parent)
     d->lixReadingEaseLabel = addStatisticLabel(tr("Reading Ease:"), d->VERY_EASY_READING_EASE_STR, tr("LIX Reading Ease"));
     d->cliLabel = addStatisticLabel(tr("Grade Level:"), "0", tr("Coleman-Liau Readability Index (CLI)"));
 
+    setStringValueForLabel(d->lixReadingEaseLabel, d->readingEaseText(d->statistics.lixReadingEase));
+    setStringValueForLabel(d->cliLabel, d->readabilityIndexText(d->statistics.readabilityIndex));
 }
 
 DocumentStatisticsWidget::~DocumentStatisticsWidget()
@@ -87,88 +95,80 @@ DocumentStatisticsWidget::~DocumentStatisticsWidget()
 
 }
 
-void DocumentStatisticsWidget::setWordCount(int value)
+void DocumentStatisticsWidget::setStatistics(const DocumentStatisticsSnapshot &statistics)
 {
     Q_D(DocumentStatisticsWidget);
-    
-    setIntegerValueForLabel(d->wordCountLabel, value);
-}
 
-void DocumentStatisticsWidget::setCharacterCount(int value)
-{
-    Q_D(DocumentStatisticsWidget);
-    
-    setIntegerValueForLabel(d->characterCountLabel, value);
-}
+    const DocumentStatisticsSnapshot &old = d->statistics;
 
-void DocumentStatisticsWidget::setParagraphCount(int value)
-{
-    Q_D(DocumentStatisticsWidget);
-    
-    setIntegerValueForLabel(d->paragraphCountLabel, value);
-}
+    if (statistics.wordCount != old.wordCount) {
+        setIntegerValueForLabel(d->wordCountLabel, statistics.wordCount);
+    }
 
-void DocumentStatisticsWidget::setSentenceCount(int value)
-{
-    Q_D(DocumentStatisticsWidget);
-    
-    setIntegerValueForLabel(d->sentenceCountLabel, value);
-}
+    if (statistics.characterCount != old.characterCount) {
+        setIntegerValueForLabel(d->characterCountLabel, statistics.characterCount);
+    }
 
-void DocumentStatisticsWidget::setPageCount(int value)
-{
-    Q_D(DocumentStatisticsWidget);
-    
-    setPageValueForLabel(d->pageCountLabel, value);
-}
+    if (statistics.sentenceCount != old.sentenceCount) {
+        setIntegerValueForLabel(d->sentenceCountLabel, statistics.sentenceCount);
+    }
 
-void DocumentStatisticsWidget::setComplexWords(int percentage)
-{
-    Q_D(DocumentStatisticsWidget);
-    
-    setPercentageValueForLabel(d->complexWordsLabel, percentage);
-}
+    if (statistics.paragraphCount != old.paragraphCount) {
+        setIntegerValueForLabel(d->paragraphCountLabel, statistics.paragraphCount);
+    }
 
-void DocumentStatisticsWidget::setReadingTime(int minutes)
-{
-    Q_D(DocumentStatisticsWidget);
-    
-    setTimeValueForLabel(d->readingTimeLabel, minutes);
+    if (statistics.pageCount != old.pageCount) {
+        setPageValueForLabel(d->pageCountLabel, statistics.pageCount);
+    }
+
+    if (statistics.complexWords != old.complexWords) {
+        setPercentageValueForLabel(d->complexWordsLabel, statistics.complexWords);
+    }
+
+    if (statistics.readingTime != old.readingTime) {
+        setTimeValueForLabel(d->readingTimeLabel, statistics.readingTime);
+    }
+
+    if (statistics.lixReadingEase != old.lixReadingEase) {
+        setStringValueForLabel(d->lixReadingEaseLabel, d->readingEaseText(statistics.lixReadingEase));
+    }
+
+    if (statistics.readabilityIndex != old.readabilityIndex) {
+        setStringValueForLabel(d->cliLabel, d->readabilityIndexText(statistics.readabilityIndex));
+    }
+
+    d->statistics = statistics;
 }
 
-void DocumentStatisticsWidget::setLixReadingEase(int value)
+QString DocumentStatisticsWidgetPrivate::readingEaseText(int value) const
 {
-    Q_D(DocumentStatisticsWidget);
-    
-    QString readingEaseStr = d->VERY_DIFFICULT_READING_EASE_STR;
+    QString readingEaseStr = VERY_DIFFICULT_READING_EASE_STR;
 
     if (value <= 25) {
-        readingEaseStr = d->VERY_EASY_READING_EASE_STR;
+        readingEaseStr = VERY_EASY_READING_EASE_STR;
     } else if (value <= 35) {
-        readingEaseStr = d->EASY_READING_EASE_STR;
+        readingEaseStr = EASY_READING_EASE_STR;
     } else if (value <= 45) {
-        readingEaseStr = d->MEDIUM_READING_EASE_STR;
+        readingEaseStr = MEDIUM_READING_EASE_STR;
     } else if (value <= 55) {
-        readingEaseStr = d->DIFFICULT_READING_EASE_STR;
+        readingEaseStr = DIFFICULT_READING_EASE_STR;
     }
 
-    setStringValueForLabel(d->lixReadingEaseLabel, readingEaseStr);
+    return readingEaseStr;
 }
 
-void DocumentStatisticsWidget::setReadabilityIndex(int value)
+QString DocumentStatisticsWidgetPrivate::readabilityIndexText(int value)
 {
-    Q_D(DocumentStatisticsWidget);
-    
-    QString cliStr = tr("Kindergarten");
+    QString cliStr = DocumentStatisticsWidget::tr("Kindergarten");
 
     if (value > 16) {
-        cliStr = tr("Rocket Science");
+        cliStr = DocumentStatisticsWidget::tr("Rocket Science");
     } else if (value > 12) {
-        cliStr = tr("College");
+        cliStr = DocumentStatisticsWidget::tr("College");
     } else if (value > 0) {
         cliStr.setNum(value);
     }
 
-    setStringValueForLabel(d->cliLabel, cliStr);
+    return cliStr;
 }
 } // namespace ghostwriter
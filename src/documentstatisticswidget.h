@@ -23,6 +23,7 @@
 #include <QScopedPointer>
 
 #include "abstractstatisticswidget.h"
+#include "documentstatistics.h"
 
 namespace ghostwriter
 {
@@ -48,49 +49,10 @@ public:
 
 public slots:
     /**
-     * Sets the word count to display.
+     * Sets the statistics to display.  Only the statistics that differ
+     * from those currently displayed are updated.
      */
-    void setWordCount(int value);
-
-    /**
-     * Sets the character count to display.
-     */
-    void setCharacterCount(int value);
-
-    /**
-     * Sets the paragraph count to display.
-     */
-    void setParagraphCount(int value);
-
-    /**
-     * Sets the sentence count to display.
-     */
-    void setSentenceCount(int value);
-
-    /**
-     * Sets the page count to display.
-     */
-    void setPageCount(int value);
-
-    /**
-     * Sets the complex word percentage to display.
-     */
-    void setComplexWords(int percentage);
-
-    /**
-     * Sets the reading time to display.
-     */
-    void setReadingTime(int minutes);
-
-    /**
-     * Sets the LIX reading ease to display.
-     */
-    void setLixReadingEase(int value);
-
-    /**
-     * Sets the Coleman-Liau readability index (CLI).
-     */
-    void setReadabilityIndex(int value);
+    void setStatistics(const DocumentStatisticsSnapshot &statistics);
 
 private:
     QScopedPointer<DocumentStatisticsWidgetPrivate> d_ptr;
@@ -30,7 +30,9 @@
 namespace ghostwriter
 {
 Exporter::Exporter(const QString &name)
-    : m_smartTypographyEnabled(false), m_name(name)
+    : m_concurrentExportsEnabled(false),
+      m_smartTypographyEnabled(false),
+      m_name(name)
 {
     ;
 }
@@ -60,6 +62,16 @@ void Exporter::setSmartTypographyEnabled(bool enabled)
     m_smartTypographyEnabled = enabled;
 }
 
+bool Exporter::concurrentExportsEnabled() const
+{
+    return m_concurrentExportsEnabled;
+}
+
+void Exporter::setConcurrentExportsEnabled(bool enabled)
+{
+    m_concurrentExportsEnabled = enabled;
+}
+
 void Exporter::exportToHtml(const QString &text, QString &html)
 {
     Q_UNUSED(text)
@@ -78,6 +78,20 @@ public:
      */
     void setSmartTypographyEnabled(bool enabled);
 
+    /**
+     * Returns true if exportToFile() may be called from several threads
+     * at once.
+     */
+    bool concurrentExportsEnabled() const;
+
+    /**
+     * Set to true if exportToFile() may be called from several threads at
+     * once, as it is for batch exports.  Exporters may then favor
+     * throughput over memory use, for example by rendering into memory
+     * rather than streaming to the output file.  Disabled by default.
+     */
+    void setConcurrentExportsEnabled(bool enabled);
+
     /**
      * Override this method to transform the given text into HTML for
      * use in the Live HTML Preview.  By default, this method will set the
@@ -113,6 +127,11 @@ protected:
     */
     QList<const ExportFormat *> m_supportedFormats;
 
+    /*
+    * Whether exportToFile() may be called from several threads at once.
+    */
+    bool m_concurrentExportsEnabled;
+
     /*
     * Use this flag to determine whether to export using smart typography
     * (i.e., fancy quotation marks, etc., typically using Smarty Pants).
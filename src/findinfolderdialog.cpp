@@ -0,0 +1,468 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QCheckBox>
+#include <QCloseEvent>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSettings>
+#include <QTreeWidget>
+#include <QTreeWidgetItem>
+
+#include "documentmanager.h"
+#include "findinfolderdialog.h"
+#include "messageboxhelper.h"
+
+#define GW_FIND_REPLACE_MATCH_CASE "FindReplace/matchCase"
+#define GW_FIND_REPLACE_WHOLE_WORD "FindReplace/wholeWord"
+#define GW_FIND_REPLACE_REGEX "FindReplace/regularExpression"
+#define GW_FIND_IN_FOLDER_PATH "FindReplace/folder"
+
+namespace ghostwriter
+{
+enum ResultItemRole
+{
+    FilePathRole = Qt::UserRole,
+    LineRole,
+    ColumnRole,
+    LengthRole
+};
+
+class FindInFolderDialogPrivate
+{
+    Q_DECLARE_PUBLIC(FindInFolderDialog)
+
+public:
+    FindInFolderDialogPrivate(FindInFolderDialog *q_ptr)
+        : q_ptr(q_ptr)
+    {
+        ;
+    }
+
+    ~FindInFolderDialogPrivate()
+    {
+        ;
+    }
+
+    FindInFolderDialog *q_ptr;
+
+    MarkdownDocument *document;
+    FolderSearch *folderSearch;
+    QLineEdit *folderField;
+    QLineEdit *findField;
+    QLineEdit *replaceField;
+    QCheckBox *matchCaseCheckBox;
+    QCheckBox *wholeWordCheckBox;
+    QCheckBox *regularExpressionCheckBox;
+    QTreeWidget *resultsTree;
+    QLabel *statusLabel;
+    QPushButton *findButton;
+    QPushButton *replaceAllButton;
+    QPushButton *stopButton;
+
+    QString searchFolder;
+    bool replacing;
+    int matchCount;
+    int fileCount;
+
+    TextMatcher matcher() const;
+    bool startSearch(bool replace);
+    void setRunning(bool running);
+    void addResult(const FolderSearchResult &result);
+    void onFinished(bool cancelled);
+
+    /*
+    * Returns the file path of the open document if it is one of the
+    * Markdown files within the given folder, or an empty string otherwise.
+    */
+    QString openFileInFolder(const QString &folder) const;
+
+    /*
+    * Makes the replacements of Replace All in the open document, as one
+    * undoable edit, and lists the result.
+    */
+    void replaceInOpenDocument
+    (
+        const QString &filePath,
+        const TextMatcher &matcher,
+        const QString &replacement
+    );
+};
+
+FindInFolderDialog::FindInFolderDialog(MarkdownDocument *document, QWidget *parent)
+    : QDialog(parent),
+      d_ptr(new FindInFolderDialogPrivate(this))
+{
+    Q_D(FindInFolderDialog);
+
+    QSettings settings;
+
+    this->setWindowTitle(tr("Find in Folder"));
+
+    d->document = document;
+    d->replacing = false;
+    d->matchCount = 0;
+    d->fileCount = 0;
+    d->folderSearch = new FolderSearch(this);
+
+    d->folderField = new QLineEdit(settings.value(GW_FIND_IN_FOLDER_PATH).toString());
+    QPushButton *browseButton = new QPushButton(tr("Browse..."));
+    d->findField = new QLineEdit();
+    d->replaceField = new QLineEdit();
+
+    d->matchCaseCheckBox = new QCheckBox(tr("Match case"));
+    d->matchCaseCheckBox->setChecked(settings.value(GW_FIND_REPLACE_MATCH_CASE, false).toBool());
+    d->wholeWordCheckBox = new QCheckBox(tr("Whole word"));
+    d->wholeWordCheckBox->setChecked(settings.value(GW_FIND_REPLACE_WHOLE_WORD, false).toBool());
+    d->regularExpressionCheckBox = new QCheckBox(tr("Regular expression"));
+    d->regularExpressionCheckBox->setChecked(settings.value(GW_FIND_REPLACE_REGEX, false).toBool());
+
+    d->resultsTree = new QTreeWidget();
+    d->resultsTree->setHeaderHidden(true);
+    d->resultsTree->setUniformRowHeights(true);
+
+    d->statusLabel = new QLabel();
+    d->findButton = new QPushButton(tr("Find"));
+    d->findButton->setDefault(true);
+    d->replaceAllButton = new QPushButton(tr("Replace All"));
+    d->stopButton = new QPushButton(tr("Stop"));
+    d->stopButton->setEnabled(false);
+    QPushButton *closeButton = new QPushButton(tr("Close"));
+
+    QHBoxLayout *optionsLayout = new QHBoxLayout();
+    optionsLayout->addWidget(d->matchCaseCheckBox);
+    optionsLayout->addWidget(d->wholeWordCheckBox);
+    optionsLayout->addWidget(d->regularExpressionCheckBox);
+    optionsLayout->addStretch();
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(d->statusLabel, 1);
+    buttonLayout->addWidget(d->findButton);
+    buttonLayout->addWidget(d->replaceAllButton);
+    buttonLayout->addWidget(d->stopButton);
+    buttonLayout->addWidget(closeButton);
+
+    QGridLayout *layout = new QGridLayout();
+    layout->addWidget(new QLabel(tr("Folder:")), 0, 0, 1, 1, Qt::AlignRight);
+    layout->addWidget(d->folderField, 0, 1, 1, 1);
+    layout->addWidget(browseButton, 0, 2, 1, 1);
+    layout->addWidget(new QLabel(tr("Find:")), 1, 0, 1, 1, Qt::AlignRight);
+    layout->addWidget(d->findField, 1, 1, 1, 2);
+    layout->addWidget(new QLabel(tr("Replace with:")), 2, 0, 1, 1, Qt::AlignRight);
+    layout->addWidget(d->replaceField, 2, 1, 1, 2);
+    layout->addLayout(optionsLayout, 3, 1, 1, 2);
+    layout->addWidget(d->resultsTree, 4, 0, 1, 3);
+    layout->addLayout(buttonLayout, 5, 0, 1, 3);
+    layout->setRowStretch(4, 1);
+    this->setLayout(layout);
+
+    this->connect(browseButton,
+        &QPushButton::clicked,
+        [this, d]() {
+            QString folder = QFileDialog::getExistingDirectory
+                (
+                    this,
+                    tr("Select Folder"),
+                    d->folderField->text()
+                );
+
+            if (!folder.isEmpty()) {
+                d->folderField->setText(QDir::toNativeSeparators(folder));
+            }
+        });
+
+    this->connect(d->findButton,
+        &QPushButton::clicked,
+        [d]() {
+            d->startSearch(false);
+        });
+
+    this->connect(d->replaceAllButton,
+        &QPushButton::clicked,
+        [d]() {
+            d->startSearch(true);
+        });
+
+    this->connect(d->stopButton,
+        &QPushButton::clicked,
+        d->folderSearch,
+        &FolderSearch::cancel);
+
+    this->connect(closeButton,
+        &QPushButton::clicked,
+        this,
+        &FindInFolderDialog::close);
+
+    this->connect(d->findField,
+        &QLineEdit::returnPressed,
+        [d]() {
+            d->startSearch(false);
+        });
+
+    this->connect(d->folderSearch,
+        &FolderSearch::resultReady,
+        [d](const FolderSearchResult &result) {
+            d->addResult(result);
+        });
+
+    this->connect(d->folderSearch,
+        &FolderSearch::finished,
+        [d](bool cancelled) {
+            d->onFinished(cancelled);
+        });
+
+    this->connect(d->resultsTree,
+        &QTreeWidget::itemActivated,
+        [this](QTreeWidgetItem *item) {
+            if (nullptr == item->parent()) {
+                return;
+            }
+
+            emit matchActivated
+            (
+                item->data(0, FilePathRole).toString(),
+                item->data(0, LineRole).toInt(),
+                item->data(0, ColumnRole).toInt(),
+                item->data(0, LengthRole).toInt()
+            );
+        });
+
+    this->resize(600, 450);
+}
+
+FindInFolderDialog::~FindInFolderDialog()
+{
+    Q_D(FindInFolderDialog);
+
+    QSettings settings;
+    settings.setValue(GW_FIND_IN_FOLDER_PATH, d->folderField->text());
+}
+
+void FindInFolderDialog::setDefaultFolder(const QString &folderPath)
+{
+    Q_D(FindInFolderDialog);
+
+    if (d->folderField->text().isEmpty()) {
+        d->folderField->setText(QDir::toNativeSeparators(folderPath));
+    }
+}
+
+void FindInFolderDialog::closeEvent(QCloseEvent *event)
+{
+    Q_D(FindInFolderDialog);
+
+    d->folderSearch->cancel();
+    QDialog::closeEvent(event);
+}
+
+TextMatcher FindInFolderDialogPrivate::matcher() const
+{
+    return TextMatcher
+    (
+        this->findField->text(),
+        this->matchCaseCheckBox->isChecked(),
+        this->wholeWordCheckBox->isChecked(),
+        this->regularExpressionCheckBox->isChecked()
+    );
+}
+
+bool FindInFolderDialogPrivate::startSearch(bool replace)
+{
+    Q_Q(FindInFolderDialog);
+
+    QString folder = QDir::fromNativeSeparators(this->folderField->text());
+    TextMatcher matcher = this->matcher();
+
+    if (folder.isEmpty() || !QDir(folder).exists()) {
+        this->statusLabel->setText(QObject::tr("Folder not found"));
+        return false;
+    }
+
+    if (!matcher.isValid()) {
+        this->statusLabel->setText(QObject::tr("Invalid search query"));
+        return false;
+    }
+
+    if (replace) {
+        QMessageBox::StandardButton response = MessageBoxHelper::question
+            (
+                q,
+                QObject::tr("Replace all matches in every file in %1?")
+                    .arg(QDir::toNativeSeparators(folder)),
+                QObject::tr("This cannot be undone."),
+                QMessageBox::Yes | QMessageBox::No,
+                QMessageBox::No
+            );
+
+        if (QMessageBox::Yes != response) {
+            return false;
+        }
+    }
+
+    this->resultsTree->clear();
+    this->searchFolder = folder;
+    this->replacing = replace;
+    this->matchCount = 0;
+    this->fileCount = 0;
+    this->statusLabel->setText(QObject::tr("Searching..."));
+    setRunning(true);
+
+    if (replace) {
+        // The open document may have unsaved changes, and rewriting its
+        // file would leave the editor out of sync with it, so replace its
+        // matches in the editor instead.
+        QString openFilePath = openFileInFolder(folder);
+        QString replacement = this->replaceField->text();
+
+        this->folderSearch->replaceAll(folder, matcher, replacement, openFilePath);
+
+        if (!openFilePath.isEmpty()) {
+            replaceInOpenDocument(openFilePath, matcher, replacement);
+        }
+    } else {
+        this->folderSearch->search(folder, matcher);
+    }
+
+    return true;
+}
+
+void FindInFolderDialogPrivate::setRunning(bool running)
+{
+    this->findButton->setEnabled(!running);
+    this->replaceAllButton->setEnabled(!running);
+    this->stopButton->setEnabled(running);
+}
+
+void FindInFolderDialogPrivate::addResult(const FolderSearchResult &result)
+{
+    QTreeWidgetItem *fileItem = new QTreeWidgetItem();
+    QString relativePath =
+        QDir::toNativeSeparators(QDir(this->searchFolder).relativeFilePath(result.filePath));
+
+    if (!result.error.isEmpty()) {
+        fileItem->setText(0, QString("%1 (%2)").arg(relativePath).arg(result.error));
+    } else if (this->replacing) {
+        fileItem->setText(0, QObject::tr("%1 (%Ln replacement(s))", "", result.replacements)
+            .arg(relativePath));
+    } else {
+        fileItem->setText(0, QObject::tr("%1 (%Ln match(es))", "", result.matches.size())
+            .arg(relativePath));
+    }
+
+    fileItem->setToolTip(0, QDir::toNativeSeparators(result.filePath));
+    fileItem->setData(0, FilePathRole, result.filePath);
+
+    // Replaced matches no longer exist in the file, so only list matches
+    // of a search.
+    if (!this->replacing) {
+        foreach (const FolderSearchMatch &match, result.matches) {
+            QTreeWidgetItem *matchItem = new QTreeWidgetItem(fileItem);
+            matchItem->setText(0, QString("%1: %2")
+                .arg(match.line + 1)
+                .arg(match.lineText.trimmed()));
+            matchItem->setData(0, FilePathRole, result.filePath);
+            matchItem->setData(0, LineRole, match.line);
+            matchItem->setData(0, ColumnRole, match.column);
+            matchItem->setData(0, LengthRole, match.length);
+        }
+    }
+
+    // Files finish in no particular order, so keep the list sorted by path.
+    int low = 0;
+    int high = this->resultsTree->topLevelItemCount();
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        if (this->resultsTree->topLevelItem(mid)->data(0, FilePathRole).toString() < result.filePath) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    this->resultsTree->insertTopLevelItem(low, fileItem);
+
+    if (result.error.isEmpty()) {
+        this->matchCount += this->replacing ? result.replacements : result.matches.size();
+        this->fileCount++;
+    }
+}
+
+void FindInFolderDialogPrivate::onFinished(bool cancelled)
+{
+    setRunning(false);
+
+    QString status;
+
+    if (this->replacing) {
+        status = QObject::tr("%Ln replacement(s)", "", this->matchCount);
+    } else {
+        status = QObject::tr("%Ln match(es)", "", this->matchCount);
+    }
+
+    status = QObject::tr("%1 in %Ln file(s)", "", this->fileCount).arg(status);
+
+    if (cancelled) {
+        status = QObject::tr("%1 (stopped)").arg(status);
+    }
+
+    this->statusLabel->setText(status);
+}
+
+QString FindInFolderDialogPrivate::openFileInFolder(const QString &folder) const
+{
+    if (this->document->isNew()) {
+        return QString();
+    }
+
+    QFileInfo fileInfo(this->document->filePath());
+    QString folderPath = QDir(folder).canonicalPath();
+
+    if (folderPath.isEmpty()
+            || !fileInfo.canonicalFilePath().startsWith(folderPath + '/')
+            || !QDir::match(DocumentManager::markdownFileNameFilters(), fileInfo.fileName())) {
+        return QString();
+    }
+
+    return this->document->filePath();
+}
+
+void FindInFolderDialogPrivate::replaceInOpenDocument
+(
+    const QString &filePath,
+    const TextMatcher &matcher,
+    const QString &replacement
+)
+{
+    FolderSearchResult result;
+    result.filePath = filePath;
+    result.replacements = matcher.replaceAll(this->document, replacement);
+
+    if (result.replacements > 0) {
+        addResult(result);
+    }
+}
+} // namespace ghostwriter
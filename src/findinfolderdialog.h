@@ -0,0 +1,81 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef FINDINFOLDERDIALOG_H
+#define FINDINFOLDERDIALOG_H
+
+#include <QDialog>
+#include <QScopedPointer>
+
+#include "foldersearch.h"
+#include "markdowndocument.h"
+
+namespace ghostwriter
+{
+/**
+ * Non-modal dialog to search for, and optionally replace, text within all
+ * of the Markdown files in a folder.  Matches are listed per file as they
+ * are found, and can be activated to open the file at the match.
+ */
+class FindInFolderDialogPrivate;
+class FindInFolderDialog : public QDialog
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(FindInFolderDialog)
+
+public:
+    /**
+     * Constructor.  Replace All makes its replacements in the given
+     * document, which is open in the editor, rather than in the file
+     * saved on disk.
+     */
+    FindInFolderDialog(MarkdownDocument *document, QWidget *parent = nullptr);
+
+    /**
+     * Destructor.
+     */
+    virtual ~FindInFolderDialog();
+
+    /**
+     * Sets the folder to search, if the user has not chosen one yet.
+     */
+    void setDefaultFolder(const QString &folderPath);
+
+signals:
+    /**
+     * Emitted when the user activates a match in the results list.
+     * The line number starts at 0.
+     */
+    void matchActivated
+    (
+        const QString &filePath,
+        int line,
+        int column,
+        int length
+    );
+
+protected:
+    void closeEvent(QCloseEvent *event);
+
+private:
+    QScopedPointer<FindInFolderDialogPrivate> d_ptr;
+};
+} // namespace ghostwriter
+
+#endif // FINDINFOLDERDIALOG_H
@@ -24,13 +24,17 @@
 #include <QMenu>
 #include <QPushButton>
 #include <QRegularExpression>
+#include <QScrollBar>
 #include <QSettings>
 #include <QStringList>
+#include <QTextBlock>
 #include <QTextEdit>
 #include <QTextCursor>
 #include <QTimer>
+#include <QVector>
 
 #include "findreplace.h"
+#include "textmatcher.h"
 #include "3rdparty/QtAwesome/QtAwesome.h"
 
 #define GW_FIND_REPLACE_MATCH_CASE "FindReplace/matchCase"
@@ -48,8 +52,7 @@ public:
     FindReplacePrivate(FindReplace *q_ptr)
         : q_ptr(q_ptr)
     {
-        this->awesome = new QtAwesome(q_ptr);
-        this->awesome->initFontAwesome();
+        this->awesome = QtAwesome::instance();
     }
 
     ~FindReplacePrivate()
@@ -59,6 +62,9 @@ public:
 
     bool findMatch(QTextCursor& cursor, bool wrap = true, bool backwards = false);
     void highlightMatches(bool enabled);
+    TextMatcher matcher() const;
+    void updateMatchIndex(int position, int charsRemoved, int charsAdded);
+    void showVisibleMatches();
     void setQueryFromSelection();
     void setReplaceRowVisible(bool visible);
     void startHighlightTimer();
@@ -68,7 +74,7 @@ public:
 
     QtAwesome *awesome;
     QGridLayout *layout;
-    QPlainTextEdit *editor;
+    MarkdownEditor *editor;
     QPushButton *matchCaseButton;
     QPushButton *wholeWordButton;
     QPushButton *regularExpressionButton;
@@ -90,15 +96,25 @@ public:
 
     QWidget *prevFocusWidget;
 
+    // Index of matches per text block, by block number, used to highlight
+    // matches without rescanning the whole document on every edit.
+    QVector<TextMatches> matchIndex;
+    int matchCount;
+    bool matchIndexValid;
+
+    // Matcher the match index was built with.
+    TextMatcher indexedMatcher;
 };
 
-FindReplace::FindReplace(QPlainTextEdit *editor, QWidget *parent)
+FindReplace::FindReplace(MarkdownEditor *editor, QWidget *parent)
     : QWidget(parent), d_ptr(new FindReplacePrivate(this))
 {
     Q_D(FindReplace);
     
     d->editor = editor;
     d->highlightTimer = nullptr;
+    d->matchCount = 0;
+    d->matchIndexValid = false;
 
     QSettings settings;
 
@@ -232,10 +248,18 @@ FindReplace::FindReplace(QPlainTextEdit *editor, QWidget *parent)
         });
 
     this->connect(d->editor->document(),
-        &QTextDocument::contentsChanged,
-        [this, d]() {
+        &QTextDocument::contentsChange,
+        [this, d](int position, int charsRemoved, int charsAdded) {
             if (this->isVisible() && d->highlightMatchesButton->isChecked()) {
-                d->highlightMatches(true);
+                d->updateMatchIndex(position, charsRemoved, charsAdded);
+            }
+        });
+
+    this->connect(d->editor->verticalScrollBar(),
+        &QScrollBar::valueChanged,
+        [this, d]() {
+            if (this->isVisible() && d->matchIndexValid) {
+                d->showVisibleMatches();
             }
         });
 
@@ -387,16 +411,9 @@ void FindReplace::replaceAll()
         showReplaceView();
     }
     
-    QTextCursor cursor = d->editor->textCursor();
-    cursor.movePosition(QTextCursor::Start);
-
-    int count = 0;
-
-    while (d->findMatch(cursor, false)) {
-        cursor.insertText(d->replaceField->text());
-        count++;
-    }
+    int count = d->matcher().replaceAll(d->editor->document(), d->replaceField->text());
 
+    d->statusLabel->setProperty("error", false);
     d->statusLabel->setText(tr("%Ln replacement(s)", "", count));
     d->editor->setFocus();
 }
@@ -463,41 +480,171 @@ bool FindReplacePrivate::findMatch(QTextCursor& cursor, bool wrap, bool backward
 
 void FindReplacePrivate::highlightMatches(bool enabled)
 {
-    // If highlights are enabled, clear any current highlights and return.
+    // If highlights are disabled, clear any current highlights and return.
     if (!enabled) {
-        this->editor->setExtraSelections(QList<QTextEdit::ExtraSelection>());
+        this->matchIndex.clear();
+        this->matchCount = 0;
+        this->matchIndexValid = false;
+        this->editor->setExtraSelections
+        (
+            ExtraSelectionLayerFindMatches,
+            QList<QTextEdit::ExtraSelection>()
+        );
+        return;
+    }
+
+    this->indexedMatcher = matcher();
+
+    QTextDocument *document = this->editor->document();
+    int cursorPosition = this->editor->textCursor().position();
+    bool movedToMatch = false;
+
+    this->matchIndex.clear();
+    this->matchIndex.reserve(document->blockCount());
+    this->matchCount = 0;
+    this->matchIndexValid = true;
+
+    for (QTextBlock block = document->begin(); block.isValid(); block = block.next()) {
+        TextMatches matches = this->indexedMatcher.matches(block.text());
+        this->matchCount += matches.size();
+
+        if (!movedToMatch && !editor->hasFocus()) {
+            foreach (const TextMatch &match, matches) {
+                int start = block.position() + match.start;
+
+                if (start >= cursorPosition) {
+                    QTextCursor cursor(document);
+                    cursor.setPosition(start);
+                    cursor.setPosition(start + match.length, QTextCursor::KeepAnchor);
+                    this->editor->setTextCursor(cursor);
+                    movedToMatch = true;
+                    break;
+                }
+            }
+        }
+
+        this->matchIndex.append(matches);
+    }
+
+    showVisibleMatches();
+
+    this->statusLabel->setProperty("error", false);
+
+    if (this->matchCount > 0) {
+        this->statusLabel->setText(QObject::tr("%1 matches").arg(this->matchCount));
+    } else {
+        this->statusLabel->setText(QObject::tr("No results"));
+        this->statusLabel->setProperty("error", true);
+    }
+}
+
+TextMatcher FindReplacePrivate::matcher() const
+{
+    return TextMatcher
+    (
+        this->findField->text(),
+        this->matchCaseButton->isChecked(),
+        this->wholeWordButton->isChecked(),
+        this->regularExpressionButton->isChecked()
+    );
+}
+
+void FindReplacePrivate::updateMatchIndex(int position, int charsRemoved, int charsAdded)
+{
+    Q_UNUSED(charsRemoved)
+
+    if (!this->matchIndexValid) {
+        highlightMatches(true);
+        return;
+    }
+
+    QTextDocument *document = this->editor->document();
+    int end = qMin(position + charsAdded, document->characterCount() - 1);
+    QTextBlock firstBlock = document->findBlock(position);
+    QTextBlock lastBlock = document->findBlock(end);
+
+    if (!firstBlock.isValid() || !lastBlock.isValid()) {
+        highlightMatches(true);
+        return;
+    }
+
+    // Blocks in the index between the first changed block and the last
+    // changed block (before the change) are replaced with the matches of
+    // the blocks now in their place.
+    int blockCountDelta = document->blockCount() - this->matchIndex.size();
+    int first = firstBlock.blockNumber();
+    int oldLast = lastBlock.blockNumber() - blockCountDelta;
+
+    if ((oldLast < first) || (oldLast >= this->matchIndex.size())) {
+        highlightMatches(true);
         return;
     }
 
+    for (int i = first; i <= oldLast; i++) {
+        this->matchCount -= this->matchIndex.at(i).size();
+    }
+
+    this->matchIndex.remove(first, oldLast - first + 1);
+
+    int i = first;
+
+    for (QTextBlock block = firstBlock; block.isValid(); block = block.next()) {
+        TextMatches matches = this->indexedMatcher.matches(block.text());
+        this->matchCount += matches.size();
+        this->matchIndex.insert(i++, matches);
+
+        if (block == lastBlock) {
+            break;
+        }
+    }
+
+    showVisibleMatches();
+
+    if (this->matchCount > 0) {
+        this->statusLabel->setText(QObject::tr("%1 matches").arg(this->matchCount));
+    } else {
+        this->statusLabel->setText(QObject::tr("No results"));
+    }
+}
+
+void FindReplacePrivate::showVisibleMatches()
+{
     QList<QTextEdit::ExtraSelection> selections;
     QColor highlightedTextColor = this->editor->palette().color(QPalette::HighlightedText);
     QColor highlightColor = this->editor->palette().color(QPalette::Highlight);
     highlightColor.setAlpha(150);
 
-    QTextCursor cursor = this->editor->textCursor();
-    cursor.movePosition(QTextCursor::Start);
+    QTextEdit::ExtraSelection selection;
+    selection.format.setForeground(highlightedTextColor);
+    selection.format.setBackground(highlightColor);
 
-    QTextEdit::ExtraSelection match;
-    match.format.setForeground(highlightedTextColor);
-    match.format.setBackground(highlightColor);
-
-    bool movedToMatch = false;
-    
-    while (findMatch(cursor, false)) {
-        match.cursor = cursor;
-        selections.append(match);
+    // Only create selections for the blocks within the viewport.  These
+    // are recreated whenever the editor is scrolled.
+    QWidget *viewport = this->editor->viewport();
+    QTextBlock block = this->editor->cursorForPosition(QPoint(0, 0)).block();
+    QTextBlock lastBlock = this->editor->cursorForPosition
+        (
+            QPoint(viewport->width(), viewport->height())
+        ).block();
+
+    while (block.isValid() && (block.blockNumber() < this->matchIndex.size())) {
+        foreach (const TextMatch &match, this->matchIndex.at(block.blockNumber())) {
+            QTextCursor cursor(block);
+            cursor.setPosition(block.position() + match.start);
+            cursor.setPosition(block.position() + match.start + match.length,
+                QTextCursor::KeepAnchor);
+            selection.cursor = cursor;
+            selections.append(selection);
+        }
 
-        if (!movedToMatch && !editor->hasFocus() && (cursor >= this->editor->textCursor())) {
-            this->editor->setTextCursor(cursor);
-            movedToMatch = true;
+        if (block == lastBlock) {
+            break;
         }
-    }
 
-    this->editor->setExtraSelections(selections);
+        block = block.next();
+    }
 
-    if (!selections.isEmpty()) {
-        this->statusLabel->setText(QObject::tr("%1 matches").arg(selections.count()));
-    }    
+    this->editor->setExtraSelections(ExtraSelectionLayerFindMatches, selections);
 }
 
 void FindReplacePrivate::setQueryFromSelection()
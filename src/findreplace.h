@@ -21,10 +21,11 @@
 #define FINDREPLACE_H
 
 #include <QObject>
-#include <QPlainTextEdit>
 #include <QScopedPointer>
 #include <QWidget>
 
+#include "markdowneditor.h"
+
 namespace ghostwriter
 {
 /**
@@ -41,7 +42,7 @@ public:
     /**
      * Constructor.
      */
-    FindReplace(QPlainTextEdit *editor, QWidget *parent = nullptr);
+    FindReplace(MarkdownEditor *editor, QWidget *parent = nullptr);
 
     /**
      * Destructor.
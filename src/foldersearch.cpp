@@ -0,0 +1,415 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QSaveFile>
+#include <QTextCodec>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
+#include "documentmanager.h"
+#include "foldersearch.h"
+
+namespace ghostwriter
+{
+/*
+* Searches a single file, optionally replacing its matches.  This is run
+* concurrently for many files, so it must not touch any shared state.
+*/
+class FileSearchTask
+{
+public:
+    typedef FolderSearchResult result_type;
+
+    FileSearchTask
+    (
+        const TextMatcher &matcher = TextMatcher(),
+        bool replace = false,
+        const QString &replacement = QString(),
+        const QString &skippedFilePath = QString()
+    ) : matcher(matcher), replace(replace), replacement(replacement),
+        skippedFilePath(skippedFilePath)
+    {
+        ;
+    }
+
+    FolderSearchResult operator()(const QString &filePath) const;
+
+private:
+    TextMatcher matcher;
+    bool replace;
+    QString replacement;
+
+    // Canonical path of the file to leave untouched, if any.
+    QString skippedFilePath;
+
+    QByteArray readFile(QFile &file, QString &error) const;
+};
+
+class FolderSearchPrivate
+{
+    Q_DECLARE_PUBLIC(FolderSearch)
+
+public:
+    FolderSearchPrivate(FolderSearch *q_ptr)
+        : q_ptr(q_ptr)
+    {
+        ;
+    }
+
+    ~FolderSearchPrivate()
+    {
+        ;
+    }
+
+    FolderSearch *q_ptr;
+    QFutureWatcher<FolderSearchResult> *watcher;
+
+    // The folder is walked in the background, since doing so can take a
+    // long time for large folders or network shares.  Once its files are
+    // known, they are searched with the pending task.
+    //
+    QFutureWatcher<QStringList> *listingWatcher;
+    QAtomicInt listingCancelled;
+    bool listing;
+    FileSearchTask pendingTask;
+
+    void start(const QString &folderPath, const FileSearchTask &task);
+
+    /*
+    * Cancels the search in progress and waits for it to stop.
+    */
+    void stop();
+
+    /*
+    * Starts searching the files found by the folder walk.
+    */
+    void onListingFinished();
+};
+
+FolderSearch::FolderSearch(QObject *parent)
+    : QObject(parent),
+      d_ptr(new FolderSearchPrivate(this))
+{
+    Q_D(FolderSearch);
+
+    qRegisterMetaType<FolderSearchResult>();
+
+    d->watcher = new QFutureWatcher<FolderSearchResult>(this);
+    d->listingWatcher = new QFutureWatcher<QStringList>(this);
+    d->listing = false;
+
+    this->connect
+    (
+        d->listingWatcher,
+        &QFutureWatcher<QStringList>::finished,
+        [d]() {
+            d->onListingFinished();
+        }
+    );
+
+    // Stream results to listeners as each file is done, rather than
+    // waiting for the whole folder to be searched.
+    this->connect
+    (
+        d->watcher,
+        &QFutureWatcher<FolderSearchResult>::resultReadyAt,
+        [this, d](int index) {
+            FolderSearchResult result = d->watcher->resultAt(index);
+
+            if (!result.matches.isEmpty() || !result.error.isEmpty()) {
+                emit resultReady(result);
+            }
+        }
+    );
+
+    this->connect
+    (
+        d->watcher,
+        &QFutureWatcher<FolderSearchResult>::finished,
+        [this, d]() {
+            emit finished(d->watcher->isCanceled());
+        }
+    );
+}
+
+FolderSearch::~FolderSearch()
+{
+    Q_D(FolderSearch);
+
+    d->watcher->disconnect(this);
+    d->listingWatcher->disconnect(this);
+    d->stop();
+}
+
+QStringList FolderSearch::markdownFiles
+(
+    const QString &folderPath,
+    const QAtomicInt *cancelled
+)
+{
+    QStringList files;
+
+    QDirIterator it
+    (
+        folderPath,
+        DocumentManager::markdownFileNameFilters(),
+        QDir::Files | QDir::Readable,
+        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks
+    );
+
+    while (it.hasNext()) {
+        if ((nullptr != cancelled) && (0 != cancelled->load())) {
+            break;
+        }
+
+        files.append(it.next());
+    }
+
+    files.sort();
+    return files;
+}
+
+void FolderSearch::search(const QString &folderPath, const TextMatcher &matcher)
+{
+    Q_D(FolderSearch);
+
+    d->start(folderPath, FileSearchTask(matcher));
+}
+
+void FolderSearch::replaceAll
+(
+    const QString &folderPath,
+    const TextMatcher &matcher,
+    const QString &replacement,
+    const QString &skippedFilePath
+)
+{
+    Q_D(FolderSearch);
+
+    QString canonicalSkippedPath;
+
+    if (!skippedFilePath.isEmpty()) {
+        canonicalSkippedPath = QFileInfo(skippedFilePath).canonicalFilePath();
+    }
+
+    d->start
+    (
+        folderPath,
+        FileSearchTask(matcher, true, replacement, canonicalSkippedPath)
+    );
+}
+
+void FolderSearch::cancel()
+{
+    Q_D(FolderSearch);
+
+    d->listingCancelled.store(1);
+    d->watcher->cancel();
+}
+
+void FolderSearchPrivate::start(const QString &folderPath, const FileSearchTask &task)
+{
+    stop();
+
+    const QAtomicInt *cancelled = &this->listingCancelled;
+
+    this->listingCancelled.store(0);
+    this->listing = true;
+    this->pendingTask = task;
+    this->listingWatcher->setFuture
+    (
+        QtConcurrent::run
+        (
+            [folderPath, cancelled]() {
+                return FolderSearch::markdownFiles(folderPath, cancelled);
+            }
+        )
+    );
+}
+
+void FolderSearchPrivate::stop()
+{
+    this->listingCancelled.store(1);
+    this->listingWatcher->waitForFinished();
+    this->listing = false;
+    this->watcher->cancel();
+    this->watcher->waitForFinished();
+}
+
+void FolderSearchPrivate::onListingFinished()
+{
+    Q_Q(FolderSearch);
+
+    // Ignore a finished notification left over from a walk that was
+    // stopped when a new search started.
+    //
+    if (!this->listing || !this->listingWatcher->future().isFinished()) {
+        return;
+    }
+
+    this->listing = false;
+
+    if (0 != this->listingCancelled.load()) {
+        emit q->finished(true);
+        return;
+    }
+
+    this->watcher->setFuture
+    (
+        QtConcurrent::mapped(this->listingWatcher->result(), this->pendingTask)
+    );
+}
+
+FolderSearchResult FileSearchTask::operator()(const QString &filePath) const
+{
+    FolderSearchResult result;
+    result.filePath = filePath;
+    result.replacements = 0;
+
+    if (!skippedFilePath.isEmpty()
+            && (QFileInfo(filePath).canonicalFilePath() == skippedFilePath)) {
+        return result;
+    }
+
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.error = file.errorString();
+        return result;
+    }
+
+    QByteArray data = readFile(file, result.error);
+
+    if (!result.error.isEmpty()) {
+        return result;
+    }
+
+    // For plain, case sensitive queries, skip files that cannot contain a
+    // match without decoding them.  Queries with spaces are excluded, since
+    // they also match non-breaking spaces.
+    if (!matcher.isRegularExpression() && matcher.isCaseSensitive()
+            && !matcher.query().contains(QLatin1Char(' '))
+            && !data.contains(matcher.query().toUtf8())) {
+        return result;
+    }
+
+    // Decode strictly, so that files which are not UTF-8 are reported
+    // rather than having their invalid bytes silently rewritten as
+    // replacement characters.  A byte order mark is kept as text so that
+    // it is written back unchanged.
+    QTextCodec::ConverterState state(QTextCodec::IgnoreHeader);
+    QString text = QTextCodec::codecForName("UTF-8")->toUnicode
+        (
+            data.constData(),
+            data.size(),
+            &state
+        );
+
+    if (state.invalidChars > 0) {
+        result.error = QObject::tr("not a UTF-8 text file");
+        return result;
+    }
+    QString replacedText;
+    int lineNumber = 0;
+    int lineStart = 0;
+    int copiedUpTo = 0;
+
+    while (lineStart <= text.length()) {
+        int lineEnd = text.indexOf(QChar('\n'), lineStart);
+
+        if (lineEnd < 0) {
+            lineEnd = text.length();
+        }
+
+        int lineLength = lineEnd - lineStart;
+
+        if ((lineLength > 0) && (QChar('\r') == text.at(lineEnd - 1))) {
+            lineLength--;
+        }
+
+        QString line = text.mid(lineStart, lineLength);
+
+        foreach (const TextMatch &match, matcher.matches(line)) {
+            FolderSearchMatch searchMatch;
+            searchMatch.line = lineNumber;
+            searchMatch.column = match.start;
+            searchMatch.length = match.length;
+            searchMatch.lineText = line;
+            result.matches.append(searchMatch);
+
+            if (replace) {
+                int start = lineStart + match.start;
+
+                replacedText.append(text.midRef(copiedUpTo, start - copiedUpTo));
+                replacedText.append(replacement);
+                copiedUpTo = start + match.length;
+                result.replacements++;
+            }
+        }
+
+        lineStart = lineEnd + 1;
+        lineNumber++;
+    }
+
+    if (replace && (result.replacements > 0)) {
+        replacedText.append(text.midRef(copiedUpTo));
+        file.close();
+
+        QSaveFile saveFile(filePath);
+
+        if (!saveFile.open(QIODevice::WriteOnly)
+                || (saveFile.write(replacedText.toUtf8()) < 0)
+                || !saveFile.commit()) {
+            result.error = saveFile.errorString();
+        }
+    }
+
+    return result;
+}
+
+QByteArray FileSearchTask::readFile(QFile &file, QString &error) const
+{
+    qint64 size = file.size();
+
+    if (size <= 0) {
+        return QByteArray();
+    }
+
+    // Map the file into memory rather than copying it into a buffer.
+    // The returned array refers to the mapped memory, which stays valid
+    // while the file remains open.
+    uchar *mapped = file.map(0, size);
+
+    if (nullptr != mapped) {
+        return QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), size);
+    }
+
+    QByteArray data = file.readAll();
+
+    if (QFile::NoError != file.error()) {
+        error = file.errorString();
+    }
+
+    return data;
+}
+} // namespace ghostwriter
@@ -0,0 +1,151 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef FOLDERSEARCH_H
+#define FOLDERSEARCH_H
+
+#include <QAtomicInt>
+#include <QMetaType>
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "textmatcher.h"
+
+namespace ghostwriter
+{
+/**
+ * A single match of the search query within a file.
+ */
+struct FolderSearchMatch
+{
+    // Line number of the match, starting at 0.
+    int line;
+
+    // Column within the line at which the match starts.
+    int column;
+
+    // Length of the match.
+    int length;
+
+    // Text of the line containing the match.
+    QString lineText;
+};
+
+/**
+ * Results of searching (or replacing within) a single file.
+ */
+struct FolderSearchResult
+{
+    QString filePath;
+    QVector<FolderSearchMatch> matches;
+
+    // Number of replacements made in the file, if replacing.
+    int replacements;
+
+    // Description of the error encountered, if the file could not be
+    // read or written.
+    QString error;
+};
+
+/**
+ * Searches all Markdown files within a folder and its subfolders for a
+ * query, using a thread pool to search many files in parallel.  Results
+ * are reported per file as soon as each file has been searched.
+ */
+class FolderSearchPrivate;
+class FolderSearch : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(FolderSearch)
+
+public:
+    /**
+     * Constructor.
+     */
+    FolderSearch(QObject *parent = nullptr);
+
+    /**
+     * Destructor.  Cancels and waits for any search in progress.
+     */
+    virtual ~FolderSearch();
+
+    /**
+     * Returns the paths of the Markdown files within the given folder
+     * and its subfolders.  If cancelled is given, the search for files
+     * stops early, returning the files found so far, as soon as it
+     * becomes non-zero.  This can be called from any thread.
+     */
+    static QStringList markdownFiles
+    (
+        const QString &folderPath,
+        const QAtomicInt *cancelled = nullptr
+    );
+
+    /**
+     * Searches the Markdown files within the given folder for the
+     * matcher's query.  Any search in progress is cancelled first.
+     */
+    void search(const QString &folderPath, const TextMatcher &matcher);
+
+    /**
+     * Replaces every match of the matcher's query within the Markdown
+     * files of the given folder with the replacement text.  Any search
+     * in progress is cancelled first.  The file at skippedFilePath, if
+     * given, is left untouched so that the caller can make its
+     * replacements in the editor instead.
+     */
+    void replaceAll
+    (
+        const QString &folderPath,
+        const TextMatcher &matcher,
+        const QString &replacement,
+        const QString &skippedFilePath = QString()
+    );
+
+public slots:
+    /**
+     * Cancels the search or replacement in progress, including the
+     * search for the folder's files.  Files already being processed are
+     * completed.
+     */
+    void cancel();
+
+signals:
+    /**
+     * Emitted for each file containing matches, or whose search failed.
+     */
+    void resultReady(const ghostwriter::FolderSearchResult &result);
+
+    /**
+     * Emitted when the search or replacement has finished, or has
+     * been cancelled.
+     */
+    void finished(bool cancelled);
+
+private:
+    QScopedPointer<FolderSearchPrivate> d_ptr;
+};
+} // namespace ghostwriter
+
+Q_DECLARE_METATYPE(ghostwriter::FolderSearchResult)
+
+#endif // FOLDERSEARCH_H
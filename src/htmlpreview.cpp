@@ -31,8 +31,11 @@
 
 #include "exporter.h"
 #include "htmlpreview.h"
+#include "latencymonitor.h"
 #include "sandboxedwebpage.h"
 #include "stringobserver.h"
+#include "taskscheduler.h"
+#include "trace.h"
 
 namespace ghostwriter
 {
@@ -59,11 +62,28 @@ public:
     bool updateAgain;
     StringObserver livePreviewHtml;
     StringObserver styleSheet;
-    QString baseUrl;
+    StringObserver baseUrl;
     QRegularExpression headingTagExp;
     Exporter *exporter;
-    QString wrapperHtml;
     QFutureWatcher<QString> *futureWatcher;
+    int renderJob;
+
+    // Whether the preview page has finished loading, and the heading to
+    // navigate to once it has, or 0 for none.
+    //
+    bool pageLoaded;
+    int pendingHeading;
+
+    // Time at which the pending preview update was requested, for the
+    // latency monitor, or -1 if none.
+    //
+    qint64 requestTime;
+
+    /*
+    * Starts converting the document to HTML in a worker thread, if the
+    * preview is visible.
+    */
+    void startRender();
 
     void onHtmlReady();
     void onLoadFinished(bool ok);
@@ -72,6 +92,8 @@ public:
      * Sets the base directory path for determining resource
      * paths relative to the web page being previewed.
      * This method is called whenever the file path changes.
+     * The page itself is not reloaded; the new base URL is sent
+     * to it over the web channel instead.
      */
     void updateBaseDir();
     /*
@@ -98,8 +120,11 @@ HtmlPreview::HtmlPreview
     d->updateInProgress = false;
     d->updateAgain = false;
     d->exporter = exporter;
+    d->requestTime = -1;
+    d->pageLoaded = false;
+    d->pendingHeading = 0;
 
-    d->baseUrl = "";
+    d->baseUrl.setText("");
     d->livePreviewHtml.setText("");
     d->styleSheet.setText("");
 
@@ -129,6 +154,19 @@ HtmlPreview::HtmlPreview
 
     d->headingTagExp.setPattern("^[Hh][1-6]$");
 
+    // Rendering is scheduled rather than started right away so that
+    // several changes to the document in a row only render once.
+    //
+    d->renderJob = TaskScheduler::instance()->addJob
+        (
+            this,
+            TaskScheduler::ViewportPriority,
+            [d]() {
+                d->startRender();
+                return true;
+            }
+        );
+
     d->futureWatcher = new QFutureWatcher<QString>(this);
     this->connect
     (
@@ -157,20 +195,33 @@ HtmlPreview::HtmlPreview
     QWebChannel *channel = new QWebChannel(this);
     channel->registerObject(QStringLiteral("stylesheet"), &d->styleSheet);
     channel->registerObject(QStringLiteral("livepreviewcontent"), &d->livePreviewHtml);
+    channel->registerObject(QStringLiteral("baseurl"), &d->baseUrl);
     this->page()->setWebChannel(channel);
 
     QFile wrapperHtmlFile(":/resources/preview.html");
+    QString wrapperHtml;
 
     if (!wrapperHtmlFile.open(QFile::ReadOnly | QFile::Text)) {
-        d->wrapperHtml = tr("Error loading resources/preview.html");
+        wrapperHtml = tr("Error loading resources/preview.html");
     } else {
         QTextStream stream(&wrapperHtmlFile);
-        d->wrapperHtml = stream.readAll();
+        wrapperHtml = stream.readAll();
         wrapperHtmlFile.close();
     }
 
-    // Set the base URL and load the preview using wrapperHtml above.
     d->updateBaseDir();
+
+    // Load the preview page once.  It is given a local file URL so that
+    // it may load resources relative to any base URL it is sent later,
+    // which is set on the page with a <base> element.
+    //
+    QString pageUrl = d->baseUrl.text();
+
+    if (pageUrl.isEmpty()) {
+        pageUrl = QUrl::fromLocalFile(QDir::homePath() + "/").toString();
+    }
+
+    this->setHtml(wrapperHtml, pageUrl);
 }
 
 HtmlPreview::~HtmlPreview()
@@ -196,34 +247,22 @@ void HtmlPreview::updatePreview()
         return;
     }
 
-    if (this->isVisible()) {
-        // Some markdown processors don't handle empty text very well
-        // and will err.  Thus, only pass in text from the document
-        // into the markdown processor if the text isn't empty or null.
-        //
-        if (d->document->isEmpty()) {
-            d->setHtmlContent("");
-        } else if (nullptr != d->exporter) {
-            QString text = d->document->toPlainText();
-
-            if (!text.isNull() && !text.isEmpty()) {
-                d->updateInProgress = true;
-                QFuture<QString> future =
-                    QtConcurrent::run
-                    (
-                        d,
-                        &HtmlPreviewPrivate::exportToHtml,
-                        d->document->toPlainText(),
-                        d->exporter
-                    );
-                d->futureWatcher->setFuture(future);
-            }
-        }
+    if (LatencyMonitor::isEnabled() && (d->requestTime < 0)) {
+        d->requestTime = LatencyMonitor::instance()->now();
     }
+
+    TaskScheduler::instance()->schedule(d->renderJob);
 }
 
 void HtmlPreview::navigateToHeading(int headingSequenceNumber)
 {
+    Q_D(HtmlPreview);
+
+    if (!d->pageLoaded) {
+        d->pendingHeading = headingSequenceNumber;
+        return;
+    }
+
     this->page()->runJavaScript
     (
         QString
@@ -238,6 +277,11 @@ void HtmlPreview::setHtmlExporter(Exporter *exporter)
     Q_D(HtmlPreview);
     
     d->exporter = exporter;
+
+    // Timings of the previous exporter no longer apply.
+    LatencyMonitor::instance()->clear(LatencyMonitor::PreviewRender);
+    LatencyMonitor::instance()->clear(LatencyMonitor::PreviewRoundTrip);
+
     d->setHtmlContent("");
     updatePreview();
 }
@@ -249,6 +293,41 @@ void HtmlPreview::setStyleSheet(const QString &css)
     d->styleSheet.setText(css);
 }
 
+void HtmlPreviewPrivate::startRender()
+{
+    Q_Q(HtmlPreview);
+
+    if (updateInProgress) {
+        updateAgain = true;
+        return;
+    }
+
+    if (q->isVisible()) {
+        // Some markdown processors don't handle empty text very well
+        // and will err.  Thus, only pass in text from the document
+        // into the markdown processor if the text isn't empty or null.
+        //
+        if (document->isEmpty()) {
+            setHtmlContent("");
+        } else if (nullptr != exporter) {
+            QString text = document->toPlainText();
+
+            if (!text.isNull() && !text.isEmpty()) {
+                updateInProgress = true;
+                QFuture<QString> future =
+                    QtConcurrent::run
+                    (
+                        this,
+                        &HtmlPreviewPrivate::exportToHtml,
+                        text,
+                        exporter
+                    );
+                futureWatcher->setFuture(future);
+            }
+        }
+    }
+}
+
 void HtmlPreviewPrivate::onHtmlReady()
 {
     Q_Q(HtmlPreview);
@@ -256,6 +335,20 @@ void HtmlPreviewPrivate::onHtmlReady()
     setHtmlContent(futureWatcher->result());
     updateInProgress = false;
 
+    if (requestTime >= 0) {
+        LatencyMonitor *monitor = LatencyMonitor::instance();
+
+        if (LatencyMonitor::isEnabled()) {
+            monitor->addSample
+            (
+                LatencyMonitor::PreviewRoundTrip,
+                monitor->now() - requestTime
+            );
+        }
+
+        requestTime = -1;
+    }
+
     if (updateAgain) {
         updateAgain = false;
         q->updatePreview();
@@ -270,25 +363,34 @@ void HtmlPreviewPrivate::onLoadFinished(bool ok)
     if (ok) {
         q->page()->runJavaScript("document.documentElement.contentEditable = false;");
     }
+
+    pageLoaded = true;
+
+    if (pendingHeading > 0) {
+        q->navigateToHeading(pendingHeading);
+        pendingHeading = 0;
+    }
 }
 
 void HtmlPreviewPrivate::updateBaseDir()
 {
     Q_Q(HtmlPreview);
     
+    QString url;
+
     if (!document->filePath().isNull() && !document->filePath().isEmpty()) {
         // Note that a forward slash ("/") is appended to the path to
         // ensure it works.  If the slash isn't there, then it won't
         // recognize the base URL for some reason.
         //
-        baseUrl =
-            QUrl::fromLocalFile(QFileInfo(document->filePath()).dir().absolutePath()
-                                + "/").toString();
-    } else {
-        this->baseUrl = "";
+        url = QUrl::fromLocalFile(QFileInfo(document->filePath()).dir().absolutePath()
+                                  + "/").toString();
+    }
+
+    if (url != baseUrl.text()) {
+        baseUrl.setText(url);
     }
 
-    q->setHtml(wrapperHtml, baseUrl);
     q->updatePreview();
 }
 
@@ -302,6 +404,7 @@ void HtmlPreview::closeEvent(QCloseEvent *event)
 
 void HtmlPreviewPrivate::setHtmlContent(const QString &html)
 {
+    GW_TRACE_SCOPE("HtmlPreview::pushContent", "preview");
     this->livePreviewHtml.setText(html);
 }
 
@@ -311,6 +414,8 @@ QString HtmlPreviewPrivate::exportToHtml
     Exporter *exporter
 ) const
 {
+    GW_TRACE_SCOPE("HtmlPreview::render", "preview");
+    LatencySample latencySample(LatencyMonitor::PreviewRender);
     QString html;
 
     // Enable smart typography for preview, if available for the exporter.
@@ -0,0 +1,151 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QLocale>
+#include <QString>
+#include <QTimer>
+
+#include "latencyindicator.h"
+#include "latencymonitor.h"
+
+namespace ghostwriter
+{
+class LatencyIndicatorPrivate
+{
+    Q_DECLARE_PUBLIC(LatencyIndicator)
+
+public:
+    LatencyIndicatorPrivate(LatencyIndicator *q_ptr)
+        : q_ptr(q_ptr)
+    {
+        ;
+    }
+
+    ~LatencyIndicatorPrivate()
+    {
+        ;
+    }
+
+    static const int REFRESH_INTERVAL_MS = 500;
+
+    LatencyIndicator *q_ptr;
+    QTimer *timer;
+
+    /*
+    * Refreshes the label with the latest statistics.
+    */
+    void refresh();
+
+    /*
+    * Formats the given duration in microseconds as milliseconds.
+    */
+    static QString milliseconds(qint64 microseconds);
+
+    /*
+    * Formats the median and 99th percentile of the given measurement.
+    */
+    static QString percentiles(LatencyMonitor::Metric metric);
+};
+
+LatencyIndicator::LatencyIndicator(QWidget *parent)
+    : QLabel(parent),
+      d_ptr(new LatencyIndicatorPrivate(this))
+{
+    Q_D(LatencyIndicator);
+
+    d->timer = new QTimer(this);
+    d->timer->setInterval(LatencyIndicatorPrivate::REFRESH_INTERVAL_MS);
+
+    this->connect
+    (
+        d->timer,
+        &QTimer::timeout,
+        [d]() {
+            d->refresh();
+        }
+    );
+
+    this->setToolTip
+    (
+        tr("Median / 99th percentile times, in milliseconds:\n"
+           "Key: keystroke until the editor is repainted\n"
+           "Parse: parsing the document (with the number of nodes)\n"
+           "Highlight: highlighting a single line\n"
+           "Preview: converting the document to HTML\n"
+           "Round trip: updating the preview after a change")
+    );
+}
+
+LatencyIndicator::~LatencyIndicator()
+{
+    LatencyMonitor::instance()->setEnabled(false);
+}
+
+void LatencyIndicator::showEvent(QShowEvent *event)
+{
+    Q_D(LatencyIndicator);
+
+    LatencyMonitor::instance()->setEnabled(true);
+    d->refresh();
+    d->timer->start();
+
+    QLabel::showEvent(event);
+}
+
+void LatencyIndicator::hideEvent(QHideEvent *event)
+{
+    Q_D(LatencyIndicator);
+
+    d->timer->stop();
+    LatencyMonitor::instance()->setEnabled(false);
+
+    QLabel::hideEvent(event);
+}
+
+void LatencyIndicatorPrivate::refresh()
+{
+    Q_Q(LatencyIndicator);
+
+    QString text = LatencyIndicator::tr("Key %1  Parse %2 (%3 nodes)  Highlight %4  Preview %5  Round trip %6")
+        .arg(percentiles(LatencyMonitor::KeystrokeToPaint))
+        .arg(percentiles(LatencyMonitor::Parse))
+        .arg(QLocale().toString(LatencyMonitor::instance()->nodeCount()))
+        .arg(percentiles(LatencyMonitor::HighlightBlock))
+        .arg(percentiles(LatencyMonitor::PreviewRender))
+        .arg(percentiles(LatencyMonitor::PreviewRoundTrip));
+
+    q->setText(text);
+}
+
+QString LatencyIndicatorPrivate::milliseconds(qint64 microseconds)
+{
+    return QLocale().toString(microseconds / 1000.0, 'f', 1);
+}
+
+QString LatencyIndicatorPrivate::percentiles(LatencyMonitor::Metric metric)
+{
+    LatencyStatistics stats = LatencyMonitor::instance()->statistics(metric);
+
+    if (stats.count <= 0) {
+        return QString("-");
+    }
+
+    return milliseconds(stats.p50) + "/" + milliseconds(stats.p99);
+}
+} // namespace ghostwriter
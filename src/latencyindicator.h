@@ -0,0 +1,60 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef LATENCY_INDICATOR_H
+#define LATENCY_INDICATOR_H
+
+#include <QLabel>
+#include <QScopedPointer>
+
+namespace ghostwriter
+{
+/**
+ * Status bar label showing live editing latencies collected by the
+ * LatencyMonitor: keystroke to paint, parse, block highlighting, and
+ * preview timings.  The monitor collects samples only while this label
+ * is visible.
+ */
+class LatencyIndicatorPrivate;
+class LatencyIndicator : public QLabel
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(LatencyIndicator)
+
+public:
+    /**
+     * Constructor.
+     */
+    explicit LatencyIndicator(QWidget *parent = nullptr);
+
+    /**
+     * Destructor.
+     */
+    virtual ~LatencyIndicator();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    QScopedPointer<LatencyIndicatorPrivate> d_ptr;
+};
+} // namespace ghostwriter
+
+#endif // LATENCY_INDICATOR_H
@@ -0,0 +1,137 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <algorithm>
+
+#include <QElapsedTimer>
+
+#include "latencymonitor.h"
+
+namespace ghostwriter
+{
+class LatencyMonitorPrivate
+{
+public:
+    LatencyMonitorPrivate()
+        : nodeCount(0)
+    {
+        ;
+    }
+
+    ~LatencyMonitorPrivate()
+    {
+        ;
+    }
+
+    QElapsedTimer clock;
+    SampleRingBuffer<LatencyMonitor::SAMPLE_CAPACITY> samples[LatencyMonitor::MetricCount];
+    std::atomic<int> nodeCount;
+};
+
+std::atomic<bool> LatencyMonitor::enabled(false);
+
+LatencyMonitor *LatencyMonitor::instance()
+{
+    static LatencyMonitor monitor;
+    return &monitor;
+}
+
+LatencyMonitor::LatencyMonitor()
+    : d_ptr(new LatencyMonitorPrivate())
+{
+    Q_D(LatencyMonitor);
+
+    d->clock.start();
+}
+
+LatencyMonitor::~LatencyMonitor()
+{
+    ;
+}
+
+void LatencyMonitor::setEnabled(bool enabled)
+{
+    Q_D(LatencyMonitor);
+
+    if (enabled && !isEnabled()) {
+        for (int i = 0; i < MetricCount; i++) {
+            d->samples[i].clear();
+        }
+    }
+
+    LatencyMonitor::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 LatencyMonitor::now() const
+{
+    Q_D(const LatencyMonitor);
+
+    return d->clock.nsecsElapsed() / 1000;
+}
+
+void LatencyMonitor::addSample(Metric metric, qint64 microseconds)
+{
+    Q_D(LatencyMonitor);
+
+    d->samples[metric].add(microseconds);
+}
+
+void LatencyMonitor::clear(Metric metric)
+{
+    Q_D(LatencyMonitor);
+
+    d->samples[metric].clear();
+}
+
+LatencyStatistics LatencyMonitor::statistics(Metric metric) const
+{
+    Q_D(const LatencyMonitor);
+
+    QVector<qint64> values = d->samples[metric].snapshot();
+    LatencyStatistics stats = {values.size(), 0, 0};
+
+    if (values.isEmpty()) {
+        return stats;
+    }
+
+    int median = (values.size() - 1) / 2;
+    int high = ((values.size() - 1) * 99) / 100;
+
+    std::nth_element(values.begin(), values.begin() + median, values.end());
+    stats.p50 = values.at(median);
+    std::nth_element(values.begin(), values.begin() + high, values.end());
+    stats.p99 = values.at(high);
+
+    return stats;
+}
+
+void LatencyMonitor::setNodeCount(int count)
+{
+    Q_D(LatencyMonitor);
+
+    d->nodeCount.store(count, std::memory_order_relaxed);
+}
+
+int LatencyMonitor::nodeCount() const
+{
+    Q_D(const LatencyMonitor);
+
+    return d->nodeCount.load(std::memory_order_relaxed);
+}
+} // namespace ghostwriter
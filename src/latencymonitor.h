@@ -0,0 +1,224 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include <atomic>
+
+#include <QScopedPointer>
+#include <QVector>
+
+namespace ghostwriter
+{
+/**
+ * Fixed-size ring buffer of the most recent samples of a measurement.
+ * Any number of threads may add samples while another thread takes
+ * snapshots, without locking.  A snapshot taken while a sample is being
+ * added may include the slot's previous value, which is harmless for
+ * the live statistics this is used for.
+ */
+template <int Capacity>
+class SampleRingBuffer
+{
+public:
+    SampleRingBuffer()
+        : writeIndex(0)
+    {
+        for (int i = 0; i < Capacity; i++) {
+            samples[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Adds a sample, overwriting the oldest one if the buffer is full.
+     */
+    void add(qint64 value)
+    {
+        unsigned int index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+        samples[index % Capacity].store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Discards all samples.
+     */
+    void clear()
+    {
+        writeIndex.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns a copy of the samples currently in the buffer, in no
+     * particular order.
+     */
+    QVector<qint64> snapshot() const
+    {
+        unsigned int count = writeIndex.load(std::memory_order_relaxed);
+
+        if (count > Capacity) {
+            count = Capacity;
+        }
+
+        QVector<qint64> values(count);
+
+        for (unsigned int i = 0; i < count; i++) {
+            values[i] = samples[i].load(std::memory_order_relaxed);
+        }
+
+        return values;
+    }
+
+private:
+    std::atomic<qint64> samples[Capacity];
+    std::atomic<unsigned int> writeIndex;
+};
+
+/**
+ * Summary of the samples of a measurement, in microseconds.
+ */
+struct LatencyStatistics
+{
+    int count;
+    qint64 p50;
+    qint64 p99;
+};
+
+/**
+ * Collects live timings of the editing pipeline for display in the status
+ * bar, so that users can see which feature is making a given document
+ * slow to edit.  Samples are only collected while the monitor is enabled.
+ */
+class LatencyMonitorPrivate;
+class LatencyMonitor
+{
+    Q_DECLARE_PRIVATE(LatencyMonitor)
+
+public:
+    /**
+     * Monitored measurements.
+     */
+    enum Metric {
+        KeystrokeToPaint,   // Key press until the editor is repainted.
+        Parse,              // Parsing the document into an AST.
+        HighlightBlock,     // Highlighting a single text block.
+        PreviewRender,      // Converting the document to HTML.
+        PreviewRoundTrip,   // Requesting a preview until it is displayed.
+        MetricCount
+    };
+
+    /**
+     * Maximum number of recent samples kept per measurement.
+     */
+    static const int SAMPLE_CAPACITY = 256;
+
+    /**
+     * Returns the single instance of this class.
+     */
+    static LatencyMonitor *instance();
+
+    /**
+     * Destructor.
+     */
+    ~LatencyMonitor();
+
+    /**
+     * Returns true if samples are being collected.
+     */
+    static bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Enables or disables collecting samples.  Samples collected
+     * previously are discarded when the monitor is enabled.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Returns a monotonic timestamp in microseconds for measuring
+     * durations with addSample().
+     */
+    qint64 now() const;
+
+    /**
+     * Adds a sample for the given measurement.  Thread safe.
+     */
+    void addSample(Metric metric, qint64 microseconds);
+
+    /**
+     * Discards the samples collected for the given measurement, e.g., when
+     * the preview's exporter changes.
+     */
+    void clear(Metric metric);
+
+    /**
+     * Returns the median and 99th percentile of the recent samples of
+     * the given measurement.
+     */
+    LatencyStatistics statistics(Metric metric) const;
+
+    /**
+     * Sets the number of nodes in the most recently parsed AST.
+     */
+    void setNodeCount(int count);
+
+    /**
+     * Returns the number of nodes in the most recently parsed AST.
+     */
+    int nodeCount() const;
+
+private:
+    static std::atomic<bool> enabled;
+
+    LatencyMonitor();
+
+    QScopedPointer<LatencyMonitorPrivate> d_ptr;
+};
+
+/**
+ * Adds the time spent between its construction and destruction as a sample
+ * of the given measurement, if the latency monitor is enabled.
+ */
+class LatencySample
+{
+public:
+    LatencySample(LatencyMonitor::Metric metric)
+        : metric(metric), start(-1)
+    {
+        if (LatencyMonitor::isEnabled()) {
+            start = LatencyMonitor::instance()->now();
+        }
+    }
+
+    ~LatencySample()
+    {
+        if (start >= 0) {
+            LatencyMonitor *monitor = LatencyMonitor::instance();
+            monitor->addSample(metric, monitor->now() - start);
+        }
+    }
+
+private:
+    LatencyMonitor::Metric metric;
+    qint64 start;
+};
+} // namespace ghostwriter
+
+#endif // LATENCY_MONITOR_H
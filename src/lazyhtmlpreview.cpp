@@ -0,0 +1,231 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "htmlpreview.h"
+#include "lazyhtmlpreview.h"
+
+namespace ghostwriter
+{
+class LazyHtmlPreviewPrivate
+{
+    Q_DECLARE_PUBLIC(LazyHtmlPreview)
+
+public:
+    LazyHtmlPreviewPrivate(LazyHtmlPreview *q_ptr)
+        : q_ptr(q_ptr)
+    {
+        ;
+    }
+
+    ~LazyHtmlPreviewPrivate()
+    {
+        ;
+    }
+
+    LazyHtmlPreview *q_ptr;
+    MarkdownDocument *document;
+    Exporter *exporter;
+    QString styleSheet;
+    int headingSequenceNumber;
+    HtmlPreview *preview;
+    QTimer *teardownTimer;
+
+    // Time in milliseconds to keep the preview while hidden, or a negative
+    // value to keep it forever.
+    //
+    int teardownDelay;
+
+    /*
+    * Creates the preview if it does not exist yet.
+    */
+    void createPreview();
+
+    /*
+    * Destroys the preview.
+    */
+    void destroyPreview();
+
+    /*
+    * Starts counting down to destroying the preview, if it exists and
+    * teardown is enabled.
+    */
+    void startTeardownTimer();
+};
+
+LazyHtmlPreview::LazyHtmlPreview
+(
+    MarkdownDocument *document,
+    Exporter *exporter,
+    QWidget *parent
+) : QWidget(parent),
+    d_ptr(new LazyHtmlPreviewPrivate(this))
+{
+    Q_D(LazyHtmlPreview);
+
+    d->document = document;
+    d->exporter = exporter;
+    d->headingSequenceNumber = 0;
+    d->preview = nullptr;
+    d->teardownDelay = -1;
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setMargin(0);
+    layout->setSpacing(0);
+
+    d->teardownTimer = new QTimer(this);
+    d->teardownTimer->setSingleShot(true);
+
+    this->connect
+    (
+        d->teardownTimer,
+        &QTimer::timeout,
+        [d]() {
+            d->destroyPreview();
+        }
+    );
+
+    this->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+}
+
+LazyHtmlPreview::~LazyHtmlPreview()
+{
+    ;
+}
+
+void LazyHtmlPreview::setTeardownDelay(int milliseconds)
+{
+    Q_D(LazyHtmlPreview);
+
+    d->teardownDelay = milliseconds;
+    d->teardownTimer->stop();
+
+    if (!this->isVisible()) {
+        d->startTeardownTimer();
+    }
+}
+
+void LazyHtmlPreview::updatePreview()
+{
+    Q_D(LazyHtmlPreview);
+
+    if (nullptr != d->preview) {
+        d->preview->updatePreview();
+    }
+}
+
+void LazyHtmlPreview::navigateToHeading(int headingSequenceNumber)
+{
+    Q_D(LazyHtmlPreview);
+
+    d->headingSequenceNumber = headingSequenceNumber;
+
+    if (nullptr != d->preview) {
+        d->preview->navigateToHeading(headingSequenceNumber);
+    }
+}
+
+void LazyHtmlPreview::setHtmlExporter(Exporter *exporter)
+{
+    Q_D(LazyHtmlPreview);
+
+    d->exporter = exporter;
+
+    if (nullptr != d->preview) {
+        d->preview->setHtmlExporter(exporter);
+    }
+}
+
+void LazyHtmlPreview::setStyleSheet(const QString &css)
+{
+    Q_D(LazyHtmlPreview);
+
+    if (css == d->styleSheet) {
+        return;
+    }
+
+    d->styleSheet = css;
+
+    if (nullptr != d->preview) {
+        d->preview->setStyleSheet(css);
+    }
+}
+
+void LazyHtmlPreview::showEvent(QShowEvent *event)
+{
+    Q_D(LazyHtmlPreview);
+
+    d->teardownTimer->stop();
+    d->createPreview();
+
+    QWidget::showEvent(event);
+}
+
+void LazyHtmlPreview::hideEvent(QHideEvent *event)
+{
+    Q_D(LazyHtmlPreview);
+
+    d->startTeardownTimer();
+
+    QWidget::hideEvent(event);
+}
+
+void LazyHtmlPreviewPrivate::createPreview()
+{
+    Q_Q(LazyHtmlPreview);
+
+    if (nullptr != preview) {
+        return;
+    }
+
+    preview = new HtmlPreview(document, exporter, q);
+    preview->setMinimumWidth(0);
+    preview->setStyleSheet(styleSheet);
+
+    if (headingSequenceNumber > 0) {
+        preview->navigateToHeading(headingSequenceNumber);
+    }
+
+    q->layout()->addWidget(preview);
+    q->setFocusProxy(preview);
+    preview->show();
+}
+
+void LazyHtmlPreviewPrivate::destroyPreview()
+{
+    Q_Q(LazyHtmlPreview);
+
+    if (nullptr == preview) {
+        return;
+    }
+
+    q->setFocusProxy(nullptr);
+    preview->deleteLater();
+    preview = nullptr;
+}
+
+void LazyHtmlPreviewPrivate::startTeardownTimer()
+{
+    if ((nullptr != preview) && (teardownDelay >= 0)) {
+        teardownTimer->start(teardownDelay);
+    }
+}
+} // namespace ghostwriter
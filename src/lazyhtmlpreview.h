@@ -0,0 +1,103 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef LAZY_HTML_PREVIEW_H
+#define LAZY_HTML_PREVIEW_H
+
+#include <QScopedPointer>
+#include <QString>
+#include <QWidget>
+
+#include "exporter.h"
+#include "markdowndocument.h"
+
+namespace ghostwriter
+{
+/**
+ * Placeholder for the HtmlPreview that only creates the preview (and with
+ * it, Chromium's renderer process) the first time it is shown, and can
+ * destroy it again after it has been hidden for the teardown delay to
+ * return its memory.  Changes to the style sheet, exporter and navigated heading made
+ * while the preview does not exist are remembered and applied when it is
+ * created.
+ */
+class LazyHtmlPreviewPrivate;
+class LazyHtmlPreview : public QWidget
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(LazyHtmlPreview)
+
+public:
+    /**
+     * Constructor.  Takes text document to be rendered as HTML as
+     * parameter.
+     */
+    LazyHtmlPreview
+    (
+        MarkdownDocument *document,
+        Exporter *exporter,
+        QWidget *parent = nullptr
+    );
+
+    /**
+     * Destructor.
+     */
+    virtual ~LazyHtmlPreview();
+
+    /**
+     * Sets how long, in milliseconds, the preview must stay hidden before
+     * it is destroyed.  Pass in a negative value to never destroy it,
+     * which is the default.
+     */
+    void setTeardownDelay(int milliseconds);
+
+public slots:
+    /**
+     * Re-renders the HTML for the document, if the preview exists.
+     * Otherwise, the document is rendered when the preview is created.
+     */
+    void updatePreview();
+
+    /**
+     * Navigates to the HTML heading having the given sequence number,
+     * starting at 1.  See HtmlPreview::navigateToHeading().
+     */
+    void navigateToHeading(int headingSequenceNumber);
+
+    /**
+     * Sets the HTML exporter used in generating HTML from the Markdown
+     * document.
+     */
+    void setHtmlExporter(Exporter *exporter);
+
+    /**
+     * Sets the CSS style sheet code of the preview.
+     */
+    void setStyleSheet(const QString &css);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    QScopedPointer<LazyHtmlPreviewPrivate> d_ptr;
+};
+} // namespace ghostwriter
+
+#endif // LAZY_HTML_PREVIEW_H
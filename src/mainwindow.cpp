@@ -40,6 +40,7 @@
 #include <QSettings>
 #include <QStatusBar>
 #include <QTemporaryFile>
+#include <QTextBlock>
 
 #include "3rdparty/QtAwesome/QtAwesome.h"
 
@@ -76,8 +77,7 @@ enum SidebarTabIndex {
 MainWindow::MainWindow(const QString &filePath, QWidget *parent)
     : QMainWindow(parent)
 {
-    this->awesome = new QtAwesome(qApp);
-    this->awesome->initFontAwesome();
+    this->awesome = QtAwesome::instance();
     QString fileToOpen;
     setWindowIcon(QIcon(":/resources/images/ghostwriter.svg"));
     this->setObjectName("mainWindow");
@@ -282,6 +282,12 @@ MainWindow::MainWindow(const QString &filePath, QWidget *parent)
         documentManager,
         &DocumentManager::documentLoaded,
         [this]() {
+            // The statistics are normally recounted in the background, so
+            // bring them up to date with the new file first.  Otherwise,
+            // the session would start from the previous file's word count,
+            // and the whole new file would count as words written.
+            //
+            this->documentStats->finishRecount();
             this->sessionStats->startNewSession(this->documentStats->wordCount());
             refreshRecentFiles();
         }
@@ -296,10 +302,10 @@ MainWindow::MainWindow(const QString &filePath, QWidget *parent)
         }
     );
 
-    // Note that the parent widget for this new window must be NULL, so that
-    // it will hide beneath other windows when it is deactivated.
+    // The web engine behind the preview is only started once the preview
+    // is first shown.
     //
-    htmlPreview = new HtmlPreview
+    htmlPreview = new LazyHtmlPreview
     (
         documentManager->document(),
         appSettings->currentHtmlExporter(),
@@ -310,6 +316,7 @@ MainWindow::MainWindow(const QString &filePath, QWidget *parent)
     connect(outlineWidget, SIGNAL(headingNumberNavigated(int)), htmlPreview, SLOT(navigateToHeading(int)));
     connect(appSettings, SIGNAL(currentHtmlExporterChanged(Exporter *)), htmlPreview, SLOT(setHtmlExporter(Exporter *)));
 
+    htmlPreview->setTeardownDelay(appSettings->htmlPreviewTeardownDelay());
     htmlPreview->setMinimumWidth(0);
     htmlPreview->setObjectName("htmlpreview");
     htmlPreview->setVisible(appSettings->htmlPreviewVisible());
@@ -322,6 +329,7 @@ MainWindow::MainWindow(const QString &filePath, QWidget *parent)
 
 
     this->findReplace = new FindReplace(this->editor, this);
+    this->findInFolderDialog = nullptr;
     statusBarWidgets.append(this->findReplace);
     this->findReplace->setVisible(false);
 
@@ -949,6 +957,65 @@ void MainWindow::toggleSidebarVisible(bool visible)
     this->showSidebarAction->blockSignals(false);
 }
 
+void MainWindow::showFindInFolder()
+{
+    if (nullptr == findInFolderDialog) {
+        findInFolderDialog = new FindInFolderDialog(documentManager->document(), this);
+
+        connect
+        (
+            findInFolderDialog,
+            SIGNAL(matchActivated(QString, int, int, int)),
+            this,
+            SLOT(openFolderSearchMatch(QString, int, int, int))
+        );
+    }
+
+    MarkdownDocument *document = documentManager->document();
+
+    if (!document->isNew()) {
+        findInFolderDialog->setDefaultFolder(QFileInfo(document->filePath()).absolutePath());
+    }
+
+    findInFolderDialog->show();
+    findInFolderDialog->raise();
+    findInFolderDialog->activateWindow();
+}
+
+void MainWindow::openFolderSearchMatch
+(
+    const QString &filePath,
+    int line,
+    int column,
+    int length
+)
+{
+    QFileInfo fileInfo(filePath);
+
+    if (documentManager->document()->isNew()
+            || (QFileInfo(documentManager->document()->filePath()) != fileInfo)) {
+        documentManager->open(filePath);
+
+        // The user may have cancelled opening the file.
+        if (QFileInfo(documentManager->document()->filePath()) != fileInfo) {
+            return;
+        }
+    }
+
+    QTextBlock block = editor->document()->findBlockByNumber(line);
+
+    if (block.isValid()) {
+        QTextCursor cursor(block);
+        cursor.setPosition(block.position() + column);
+        cursor.setPosition(block.position() + column + length, QTextCursor::KeepAnchor);
+        editor->setTextCursor(cursor);
+        editor->centerCursor();
+    }
+
+    this->activateWindow();
+    editor->setFocus();
+}
+
 QAction* MainWindow::createWindowAction
 (
     const QString &text,
@@ -1035,6 +1102,7 @@ void MainWindow::buildMenuBar()
     editMenu->addAction(createWindowAction(tr("Rep&lace"), findReplace, SLOT(showReplaceView()), QKeySequence("Ctrl+H")));
     editMenu->addAction(createWindowAction(tr("Find &Next"), findReplace, SLOT(findNext()), QKeySequence::FindNext));
     editMenu->addAction(createWindowAction(tr("Find &Previous"), findReplace, SLOT(findPrevious()), QKeySequence::FindPrevious));
+    editMenu->addAction(createWindowAction(tr("Find in F&older..."), this, SLOT(showFindInFolder()), QKeySequence("SHIFT+CTRL+F")));
     editMenu->addSeparator();
     editMenu->addAction(createWindowAction(tr("&Spell check"), editor, SLOT(runSpellChecker())));
 
@@ -1119,6 +1187,16 @@ void MainWindow::buildMenuBar()
     viewMenu->addAction(createWidgetAction(tr("Increase Font Size"), editor, SLOT(increaseFontSize()), QKeySequence("CTRL++")));
     viewMenu->addAction(createWidgetAction(tr("Decrease Font Size"), editor, SLOT(decreaseFontSize()), QKeySequence("CTRL+-")));
 
+    viewMenu->addSeparator();
+    QAction *latencyMonitorAction = viewMenu->addAction(tr("Show &Latency Monitor"));
+    latencyMonitorAction->setCheckable(true);
+    latencyMonitorAction->setChecked(false);
+    this->connect(latencyMonitorAction,
+        &QAction::toggled,
+        [this](bool checked) {
+            latencyIndicator->setVisible(checked);
+        });
+
     QMenu *settingsMenu = this->menuBar()->addMenu(tr("&Settings"));
     settingsMenu->addAction(createWindowAction(tr("Themes..."), this, SLOT(changeTheme())));
     settingsMenu->addAction(createWindowAction(tr("Font..."), this, SLOT(changeFont())));
@@ -1240,10 +1318,16 @@ void MainWindow::buildStatusBar()
 
     midLayout->addWidget(statisticsIndicator, 0, Qt::AlignCenter);
     midLayout->addWidget(dictionaryIndicator, 0, Qt::AlignCenter);
+
+    // Latency monitor, shown on demand from the View menu.
+    latencyIndicator = new LatencyIndicator(this);
+    latencyIndicator->hide();
+    midLayout->addWidget(latencyIndicator, 0, Qt::AlignCenter);
     midWidget->setContentsMargins(0, 0, 0, 0);
     statusBarLayout->addWidget(midWidget, 1, 1, 1, 1, Qt::AlignCenter);
     statusBarWidgets.append(statisticsIndicator);
     statusBarWidgets.append(dictionaryIndicator);
+    statusBarWidgets.append(latencyIndicator);
 
     // Add right-most widgets to status bar.
     QPushButton *button = new QPushButton(QChar(fa::moon));
@@ -1381,24 +1465,8 @@ void MainWindow::buildSidebar()
     outlineWidget->setAlternatingRowColors(false);
 
     documentStats = new DocumentStatistics((MarkdownDocument *) editor->document(), this);
-    connect(documentStats, &DocumentStatistics::wordCountChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setWordCount);
-    connect(documentStats, &DocumentStatistics::characterCountChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setCharacterCount);
-    connect(documentStats, &DocumentStatistics::sentenceCountChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setSentenceCount);
-    connect(documentStats, &DocumentStatistics::paragraphCountChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setParagraphCount);
-    connect(documentStats, &DocumentStatistics::pageCountChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setPageCount);
-    connect(documentStats, &DocumentStatistics::complexWordsChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setComplexWords);
-    connect(documentStats, &DocumentStatistics::readingTimeChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setReadingTime);
-    connect(documentStats, &DocumentStatistics::lixReadingEaseChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setLixReadingEase);
-    connect(documentStats, &DocumentStatistics::readabilityIndexChanged,
-            documentStatsWidget, &DocumentStatisticsWidget::setReadabilityIndex);
+    connect(documentStats, &DocumentStatistics::statisticsChanged,
+            documentStatsWidget, &DocumentStatisticsWidget::setStatistics);
     connect(editor, SIGNAL(textSelected(QString, int, int)), documentStats, SLOT(onTextSelected(QString, int, int)));
     connect(editor, SIGNAL(textDeselected()), documentStats, SLOT(onTextDeselected()));
 
@@ -1554,40 +1622,61 @@ void MainWindow::applyTheme()
         appSettings->previewCodeFont());
 
     editor->setColorScheme(colorScheme);
-    editor->setStyleSheet(styler.editorStyleSheet());
+
+    // Only hand widgets the style sheets that actually changed, since
+    // setting a style sheet makes Qt repolish the widget and all of its
+    // children, even if the new style sheet is identical to the old one.
+    //
+    applyStyleSheet(editor, styler.editorStyleSheet());
 
     // Do not call this->setStyleSheet().  Calling it more than once in a run
     // (i.e., when changing a theme) causes a crash in Qt 5.11.  Instead,
     // change the main window's style sheet via qApp.
     //
-    qApp->setStyleSheet(styler.layoutStyleSheet());
+    if (qApp->styleSheet() != styler.layoutStyleSheet()) {
+        qApp->setStyleSheet(styler.layoutStyleSheet());
+    }
 
-    previewSplitter->setStyleSheet(styler.splitterStyleSheet());
-    sidebarSplitter->setStyleSheet(styler.splitterStyleSheet());
-    this->statusBar()->setStyleSheet(styler.statusBarStyleSheet());
+    applyStyleSheet(previewSplitter, styler.splitterStyleSheet());
+    applyStyleSheet(sidebarSplitter, styler.splitterStyleSheet());
+    applyStyleSheet(this->statusBar(), styler.statusBarStyleSheet());
 
     foreach (QWidget *w, statusBarWidgets) {
-        w->setStyleSheet(styler.statusBarWidgetsStyleSheet());
+        applyStyleSheet(w, styler.statusBarWidgetsStyleSheet());
     }
 
-    findReplace->setStyleSheet(styler.findReplaceStyleSheet());
-    sidebar->setStyleSheet(styler.sidebarStyleSheet());
+    applyStyleSheet(findReplace, styler.findReplaceStyleSheet());
+    applyStyleSheet(sidebar, styler.sidebarStyleSheet());
 
     // Clear style sheet cache by setting to empty string before
     // setting the new style sheet.
     //
-    outlineWidget->setStyleSheet("");
-    outlineWidget->setStyleSheet(styler.sidebarWidgetStyleSheet());
-    cheatSheetWidget->setStyleSheet("");
-    cheatSheetWidget->setStyleSheet(styler.sidebarWidgetStyleSheet());
-    documentStatsWidget->setStyleSheet("");
-    documentStatsWidget->setStyleSheet(styler.sidebarWidgetStyleSheet());
-    sessionStatsWidget->setStyleSheet("");
-    sessionStatsWidget->setStyleSheet(styler.sidebarWidgetStyleSheet());
+    applyStyleSheet(outlineWidget, styler.sidebarWidgetStyleSheet(), true);
+    applyStyleSheet(cheatSheetWidget, styler.sidebarWidgetStyleSheet(), true);
+    applyStyleSheet(documentStatsWidget, styler.sidebarWidgetStyleSheet(), true);
+    applyStyleSheet(sessionStatsWidget, styler.sidebarWidgetStyleSheet(), true);
 
     htmlPreview->setStyleSheet(styler.htmlPreviewCss());
 
     adjustEditorWidth(this->width());
 }
 
+void MainWindow::applyStyleSheet
+(
+    QWidget *widget,
+    const QString &styleSheet,
+    bool clearFirst
+)
+{
+    if (widget->styleSheet() == styleSheet) {
+        return;
+    }
+
+    if (clearFirst) {
+        widget->setStyleSheet("");
+    }
+
+    widget->setStyleSheet(styleSheet);
+}
+
 } // namespace ghostwriter
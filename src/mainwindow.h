@@ -32,8 +32,10 @@
 #include "documentmanager.h"
 #include "documentstatistics.h"
 #include "documentstatisticswidget.h"
+#include "findinfolderdialog.h"
 #include "findreplace.h"
-#include "htmlpreview.h"
+#include "lazyhtmlpreview.h"
+#include "latencyindicator.h"
 #include "outlinewidget.h"
 #include "sessionstatistics.h"
 #include "sessionstatisticswidget.h"
@@ -99,11 +101,14 @@ private slots:
     void onAboutToShowMenuBarMenu();
     void onSidebarVisibilityChanged(bool visible);
     void toggleSidebarVisible(bool visible);
+    void showFindInFolder();
+    void openFolderSearchMatch(const QString &filePath, int line, int column, int length);
 
 private:
     QtAwesome *awesome;
     MarkdownEditor *editor;
     FindReplace* findReplace;
+    FindInFolderDialog *findInFolderDialog;
     QSplitter *previewSplitter;
     QSplitter *sidebarSplitter;
     DocumentManager *documentManager;
@@ -114,6 +119,7 @@ private:
     QPushButton *sidebarToggleButton;
     StatisticsIndicator *statisticsIndicator;
     DictionaryIndicator *dictionaryIndicator;
+    LatencyIndicator *latencyIndicator;
     QLabel *statusIndicator;
     TimeLabel *timeIndicator;
     QPushButton *toggleSidebarButton;
@@ -123,7 +129,7 @@ private:
     QPushButton *hemingwayModeButton;
     QPushButton *focusModeButton;
     QPushButton *htmlPreviewButton;
-    HtmlPreview *htmlPreview;
+    LazyHtmlPreview *htmlPreview;
     QWidget *editorPane;
     QAction *htmlPreviewMenuAction;
     QAction *fullScreenMenuAction;
@@ -164,6 +170,18 @@ private:
     void buildSidebar();
 
     void adjustEditorWidth(int width, bool resizeEvent = false);
+
+    /*
+     * Sets the widget's style sheet, unless it is already set to the given
+     * one.  If clearFirst is true, the style sheet is cleared before the
+     * new one is set, which flushes Qt's style sheet cache for the widget.
+     */
+    void applyStyleSheet
+    (
+        QWidget *widget,
+        const QString &styleSheet,
+        bool clearFirst = false
+    );
 };
 } // namespace ghostwriter
 
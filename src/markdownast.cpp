@@ -24,6 +24,7 @@
 #include "3rdparty/cmark-gfm/src/cmark-gfm.h"
 
 #include "markdownast.h"
+#include "trace.h"
 
 namespace ghostwriter
 {
@@ -42,6 +43,7 @@ public:
 
     MemoryArena<MarkdownNode> arena;
     MarkdownNode *root;
+    int nodeCount;
 };
 
 MarkdownAST::MarkdownAST()
@@ -50,6 +52,7 @@ MarkdownAST::MarkdownAST()
     Q_D(MarkdownAST);
     
     d->root = nullptr;
+    d->nodeCount = 0;
 }
 
 MarkdownAST::MarkdownAST(cmark_node *root)
@@ -76,8 +79,10 @@ MarkdownNode *MarkdownAST::root()
 void MarkdownAST::setRoot(cmark_node *root)
 {
     Q_D(MarkdownAST);
-    
+    GW_TRACE_SCOPE("MarkdownAST::setRoot", "parser");
+
     d->arena.freeAll();
+    d->nodeCount = 0;
 
     if (nullptr == root) {
         d->root = nullptr;
@@ -85,6 +90,7 @@ void MarkdownAST::setRoot(cmark_node *root)
     }
 
     d->root = d->arena.allocate();
+    d->nodeCount = 1;
 
     // Clone the node into memory that isn't allocated to
     // cmark-gfm's arena memory.
@@ -107,6 +113,7 @@ void MarkdownAST::setRoot(cmark_node *root)
         while (NULL != source) {
             fromNodes.push(source);
             dest = d->arena.allocate();
+            d->nodeCount++;
             destParent->appendChild(dest);
             toNodes.push(dest);
             source = cmark_node_next(source);
@@ -114,6 +121,13 @@ void MarkdownAST::setRoot(cmark_node *root)
     }
 }
 
+int MarkdownAST::nodeCount() const
+{
+    Q_D(const MarkdownAST);
+
+    return d->nodeCount;
+}
+
 MarkdownNode *MarkdownAST::findBlockAtLine(int lineNumber) const
 {
     Q_D(const MarkdownAST);
@@ -201,6 +215,7 @@ void MarkdownAST::clear()
     
     d->arena.freeAll();
     d->root = nullptr;
+    d->nodeCount = 0;
 }
 
 QString MarkdownAST::toString() const
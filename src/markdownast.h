@@ -86,6 +86,11 @@ public:
      */
     QVector<MarkdownNode *> headings() const;
 
+    /**
+     * Returns the number of nodes in the AST.
+     */
+    int nodeCount() const;
+
     /**
      * Frees memory for this AST.
      */
@@ -159,6 +159,7 @@ void MarkdownDocument::setMarkdownAST(MarkdownAST *ast)
     Q_D(MarkdownDocument);
 
     d->ast = ast;
+    emit markdownASTChanged();
 }
 
 void MarkdownDocument::clear()
@@ -118,6 +118,12 @@ signals:
      */
     void cleared();
 
+    /**
+     * Emitted when a new Markdown AST is set for the document, i.e.,
+     * after the document text has been parsed.
+     */
+    void markdownASTChanged();
+
 private:
     QScopedPointer<MarkdownDocumentPrivate> d_ptr;
 };
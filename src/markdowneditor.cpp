@@ -19,6 +19,8 @@
  *
  ***********************************************************************/
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QChar>
 #include <QColor>
@@ -51,12 +53,15 @@
 #include <QTextCursor>
 
 #include "cmarkgfmapi.h"
+#include "latencymonitor.h"
 #include "markdowneditor.h"
 #include "markdownhighlighter.h"
 #include "markdownstates.h"
 #include "spelling/dictionary_manager.h"
 #include "spelling/dictionary_ref.h"
 #include "spelling/spell_checker.h"
+#include "textblockdata.h"
+#include "trace.h"
 
 #define GW_TEXT_FADE_FACTOR 1.5
 
@@ -101,6 +106,7 @@ public:
     QList<QAction *> spellingActions;
     bool hemingwayModeEnabled;
     FocusMode focusMode;
+    QList<QTextEdit::ExtraSelection> extraSelections[ExtraSelectionLayerLast + 1];
     QBrush fadeColor;
     QColor blockColor;
     bool insertSpacesForTabs;
@@ -127,6 +133,12 @@ public:
     QHash<QChar, QChar> nonEmptyMarkupPairs;
 
     bool mouseButtonDown;
+
+    // Time of the last key press not yet followed by a repaint, for the
+    // latency monitor, or -1 if none.
+    //
+    qint64 keyPressTime;
+
     QColor cursorColor;
     bool textCursorVisible;
     QTimer *cursorBlinkTimer;
@@ -164,9 +176,46 @@ public:
         QRegularExpressionMatch &match
     );
 
-    bool insideBlockArea(const QTextBlock &block, BlockType &type) const;
-    bool atBlockAreaStart(const QTextBlock &block, BlockType &type) const;
-    bool atBlockAreaEnd(const QTextBlock &block, const BlockType type) const;
+    /*
+    * Returns the paint metadata cached in the given block's user data,
+    * recomputing it first if the block's text or state (or the previous
+    * block's state) has changed since it was cached.
+    */
+    TextBlockData *paintData(QTextBlock block);
+
+    /*
+    * Returns the rectangle in which the text cursor/caret is drawn.
+    */
+    QRect caretRect() const;
+
+    /*
+    * Returns a rectangular path with rounded bottom corners and square
+    * top corners, for block areas whose top is clipped by the viewport.
+    */
+    static QPainterPath clippedBlockAreaPath(const QRectF &rect, qreal radius);
+
+    /*
+    * Returns the sentence boundaries (positions within the block) of
+    * the given block, which are cached in the block's user data until
+    * its text changes.
+    */
+    const QVector<int> &sentenceBoundaries(QTextBlock block);
+
+    /*
+    * Gets the range of document positions for the text blocks that are
+    * currently visible within the viewport.
+    */
+    void visibleRange(int &start, int &end) const;
+
+    /*
+    * Returns an extra selection fading out the text between the given
+    * document positions for focus mode.
+    */
+    QTextEdit::ExtraSelection fadedSelection(int start, int end) const;
+
+    bool insideBlockArea(const QTextBlock &block, BlockType &type);
+    bool atBlockAreaStart(const QTextBlock &block, BlockType &type);
+    bool atBlockAreaEnd(const QTextBlock &block, const BlockType type);
     bool atCodeBlockStart(const QTextBlock &block) const;
     bool atCodeBlockEnd(const QTextBlock &block) const;
     bool isBlockquote(const QTextBlock &block) const;
@@ -188,6 +237,7 @@ MarkdownEditor::MarkdownEditor
     d->autoMatchEnabled = true;
     d->bulletPointCyclingEnabled = true;
     d->mouseButtonDown = false;
+    d->keyPressTime = -1;
 
     this->setDocument(textDocument);
     this->setAcceptDrops(true);
@@ -413,29 +463,32 @@ void MarkdownEditor::paintEvent(QPaintEvent *event)
         }
 
         if (drawBlock) {
-            painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-            painter.setPen(Qt::NoPen);
-            painter.setBrush(QBrush(d->blockColor));
-
-            // If the first visible block is "clipped" such that the previous block
-            // is part of the text block area, then only draw a rectangle with the
-            // bottom corners rounded, and with the top corners square to reflect
-            // that the first visible block is part of a larger block of text.
+            // Skip block areas outside of the region being repainted, such
+            // as when only the text cursor is blinking.
             //
-            if (clipTop) {
-                QPainterPath path;
-                path.setFillRule(Qt::WindingFill);
-                path.addRoundedRect(blockAreaRect, cornerRadius, cornerRadius);
-                qreal adjustedHeight = blockAreaRect.height() / 2;
-                path.addRect(blockAreaRect.adjusted(0, 0, 0, -adjustedHeight));
-                painter.drawPath(path.simplified());
-                clipTop = false;
-            }
-            // Else draw the entire rectangle with all corners rounded.
-            else {
-                painter.drawRoundedRect(blockAreaRect, cornerRadius, cornerRadius);
+            if (blockAreaRect.intersects(event->rect())) {
+                painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+                painter.setPen(Qt::NoPen);
+                painter.setBrush(QBrush(d->blockColor));
+
+                // If the first visible block is "clipped" such that the previous block
+                // is part of the text block area, then only draw a rectangle with the
+                // bottom corners rounded, and with the top corners square to reflect
+                // that the first visible block is part of a larger block of text.
+                //
+                if (clipTop) {
+                    painter.drawPath
+                    (
+                        MarkdownEditorPrivate::clippedBlockAreaPath(blockAreaRect, cornerRadius)
+                    );
+                }
+                // Else draw the entire rectangle with all corners rounded.
+                else {
+                    painter.drawRoundedRect(blockAreaRect, cornerRadius, cornerRadius);
+                }
             }
 
+            clipTop = false;
             drawBlock = false;
         }
 
@@ -445,12 +498,17 @@ void MarkdownEditor::paintEvent(QPaintEvent *event)
         // Credit goes to Patrizio Bekerle (qmarkdowntextedit) for discovering
         // this workaround.
         //
-        if (block.text().isRightToLeft()) {
+        // The text direction is cached with the block so that its text
+        // does not need to be scanned on every repaint.
+        //
+        if (d->paintData(block)->rightToLeft) {
             QTextLayout *layout = block.layout();
-            QTextOption opt = document()->defaultTextOption();
-            opt = QTextOption(Qt::AlignRight);
-            opt.setTextDirection(Qt::RightToLeft);
-            layout->setTextOption(opt);
+
+            if (layout->textOption().textDirection() != Qt::RightToLeft) {
+                QTextOption opt(Qt::AlignRight);
+                opt.setTextDirection(Qt::RightToLeft);
+                layout->setTextOption(opt);
+            }
         }
 
         block = block.next();
@@ -464,18 +522,24 @@ void MarkdownEditor::paintEvent(QPaintEvent *event)
 
     // Draw the text cursor/caret.
     if (d->textCursorVisible && this->hasFocus()) {
-        // Get the cursor rect so that we have the ideal height for it,
-        // and then set it to be 2 pixels wide.  (The width will be zero,
-        // because we set it to be that in the constructor so that
-        // QPlainTextEdit will not draw another cursor underneath this one.)
-        //
-        QRect r = cursorRect();
-        r.setWidth(2);
-
         QPainter painter(viewport());
-        painter.fillRect(r, QBrush(d->cursorColor));
+        painter.fillRect(d->caretRect(), QBrush(d->cursorColor));
         painter.end();
     }
+
+    if (d->keyPressTime >= 0) {
+        LatencyMonitor *monitor = LatencyMonitor::instance();
+
+        if (LatencyMonitor::isEnabled()) {
+            monitor->addSample
+            (
+                LatencyMonitor::KeystrokeToPaint,
+                monitor->now() - d->keyPressTime
+            );
+        }
+
+        d->keyPressTime = -1;
+    }
 }
 
 void MarkdownEditor::setDictionary(const QString &language)
@@ -527,12 +591,14 @@ void MarkdownEditor::setFocusMode(FocusMode mode)
         connect(this, SIGNAL(cursorPositionChanged()), this, SLOT(focusText()));
         connect(this, SIGNAL(selectionChanged()), this, SLOT(focusText()));
         connect(this, SIGNAL(textChanged()), this, SLOT(focusText()));
+        connect(this->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(focusText()));
         this->focusText();
     } else {
         disconnect(this, SIGNAL(cursorPositionChanged()), this, SLOT(focusText()));
         disconnect(this, SIGNAL(selectionChanged()), this, SLOT(focusText()));
         disconnect(this, SIGNAL(textChanged()), this, SLOT(focusText()));
-        this->setExtraSelections(QList<QTextEdit::ExtraSelection>());
+        disconnect(this->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(focusText()));
+        this->setExtraSelections(ExtraSelectionLayerFocusMode, QList<QTextEdit::ExtraSelection>());
     }
 }
 
@@ -580,6 +646,25 @@ void MarkdownEditor::setShowTabsAndSpacesEnabled(bool enabled)
     d->textDocument->setDefaultTextOption(option);
 }
 
+void MarkdownEditor::setExtraSelections
+(
+    ExtraSelectionLayer layer,
+    const QList<QTextEdit::ExtraSelection> &selections
+)
+{
+    Q_D(MarkdownEditor);
+
+    d->extraSelections[layer] = selections;
+
+    QList<QTextEdit::ExtraSelection> allSelections;
+
+    for (int i = ExtraSelectionLayerFirst; i <= ExtraSelectionLayerLast; i++) {
+        allSelections.append(d->extraSelections[i]);
+    }
+
+    QPlainTextEdit::setExtraSelections(allSelections);
+}
+
 void MarkdownEditor::setupPaperMargins()
 {
     Q_D(MarkdownEditor);
@@ -587,6 +672,7 @@ void MarkdownEditor::setupPaperMargins()
     if (EditorWidthFull == d->editorWidth) {
         d->preferredLayout->setContentsMargins(0, 0, 0, 0);
         setViewportMargins(0, 0, 0, 0);
+        this->focusText();
 
         return;
     }
@@ -614,6 +700,9 @@ void MarkdownEditor::setupPaperMargins()
 
     d->preferredLayout->setContentsMargins(0, 0, 0, 0);
     this->setViewportMargins(margin, 20, margin, 0);
+
+    // The number of visible lines may have changed.
+    this->focusText();
 }
 
 void MarkdownEditor::dragEnterEvent(QDragEnterEvent *e)
@@ -718,6 +807,18 @@ void MarkdownEditor::keyPressEvent(QKeyEvent *e)
     
     int key = e->key();
 
+    // Only time keys that edit the text, since other keys might not
+    // cause a repaint at all.
+    //
+    if
+    (
+        LatencyMonitor::isEnabled()
+        && (d->keyPressTime < 0)
+        && !e->text().isEmpty()
+    ) {
+        d->keyPressTime = LatencyMonitor::instance()->now();
+    }
+
     QTextCursor cursor(this->textCursor());
 
     switch (key) {
@@ -1701,7 +1802,6 @@ void MarkdownEditor::suggestSpelling(QAction *action)
     if (action == d->addWordToDictionaryAction) {
         this->setTextCursor(d->cursorForWord);
         d->dictionary.addToPersonal(d->wordUnderMouse);
-        d->highlighter->rehighlight();
     } else if (action == d->checkSpellingAction) {
         this->setTextCursor(d->cursorForWord);
         SpellChecker::checkDocument(this, d->highlighter, d->dictionary);
@@ -1757,95 +1857,110 @@ void MarkdownEditor::focusText()
     Q_D(MarkdownEditor);
     
     if (FocusModeDisabled != d->focusMode) {
-        QTextEdit::ExtraSelection beforeFadedSelection;
-        QTextEdit::ExtraSelection afterFadedSelection;
-        beforeFadedSelection.format.setForeground(d->fadeColor);
-        beforeFadedSelection.cursor = this->textCursor();
-        afterFadedSelection.format.setForeground(d->fadeColor);
-        afterFadedSelection.cursor = this->textCursor();
-
-        bool canFadePrevious = false;
+        // Document range of the text to keep in focus.  Text before
+        // focusStart and after focusEnd is faded.
+        //
+        int focusStart = 0;
+        int focusEnd = 0;
+        bool fade = true;
 
-        QList<QTextEdit::ExtraSelection> selections;
+        QTextCursor beforeCursor = this->textCursor();
+        QTextCursor afterCursor = this->textCursor();
 
         switch (d->focusMode) {
         case FocusModeCurrentLine: // Current line
-            beforeFadedSelection.cursor.movePosition(QTextCursor::StartOfLine);
-            canFadePrevious = beforeFadedSelection.cursor.movePosition(QTextCursor::Up);
-            beforeFadedSelection.cursor.movePosition(QTextCursor::EndOfLine);
-            beforeFadedSelection.cursor.movePosition(QTextCursor::Start, QTextCursor::KeepAnchor);
+            beforeCursor.movePosition(QTextCursor::StartOfLine);
 
-            if (canFadePrevious) {
-                selections.append(beforeFadedSelection);
+            if (beforeCursor.movePosition(QTextCursor::Up)) {
+                beforeCursor.movePosition(QTextCursor::EndOfLine);
+                focusStart = beforeCursor.position();
             }
 
-            afterFadedSelection.cursor.movePosition(QTextCursor::EndOfLine);
-            afterFadedSelection.cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
-            selections.append(afterFadedSelection);
+            afterCursor.movePosition(QTextCursor::EndOfLine);
+            focusEnd = afterCursor.position();
             break;
 
         case FocusModeThreeLines: // Current line and previous two lines
-            beforeFadedSelection.cursor.movePosition(QTextCursor::StartOfLine);
-            canFadePrevious = beforeFadedSelection.cursor.movePosition(QTextCursor::Up, QTextCursor::MoveAnchor, 2);
-            beforeFadedSelection.cursor.movePosition(QTextCursor::EndOfLine);
-            beforeFadedSelection.cursor.movePosition(QTextCursor::Start, QTextCursor::KeepAnchor);
+            beforeCursor.movePosition(QTextCursor::StartOfLine);
 
-            if (canFadePrevious) {
-                selections.append(beforeFadedSelection);
+            if (beforeCursor.movePosition(QTextCursor::Up, QTextCursor::MoveAnchor, 2)) {
+                beforeCursor.movePosition(QTextCursor::EndOfLine);
+                focusStart = beforeCursor.position();
             }
 
-            afterFadedSelection.cursor.movePosition(QTextCursor::Down);
-            afterFadedSelection.cursor.movePosition(QTextCursor::EndOfLine);
-            afterFadedSelection.cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
-            selections.append(afterFadedSelection);
+            afterCursor.movePosition(QTextCursor::Down);
+            afterCursor.movePosition(QTextCursor::EndOfLine);
+            focusEnd = afterCursor.position();
             break;
 
         case FocusModeParagraph: // Current paragraph
-            canFadePrevious = beforeFadedSelection.cursor.movePosition(QTextCursor::StartOfBlock);
-            beforeFadedSelection.cursor.movePosition(QTextCursor::Start, QTextCursor::KeepAnchor);
-            selections.append(beforeFadedSelection);
-            afterFadedSelection.cursor.movePosition(QTextCursor::EndOfBlock);
-            afterFadedSelection.cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
-            selections.append(afterFadedSelection);
+            beforeCursor.movePosition(QTextCursor::StartOfBlock);
+            focusStart = beforeCursor.position();
+            afterCursor.movePosition(QTextCursor::EndOfBlock);
+            focusEnd = afterCursor.position();
             break;
 
         case FocusModeSentence: { // Current sentence
-            QTextBoundaryFinder boundaryFinder(QTextBoundaryFinder::Sentence, this->textCursor().block().text());
+            QTextBlock block = this->textCursor().block();
+            const QVector<int> &boundaries = d->sentenceBoundaries(block);
             int currentPos = this->textCursor().positionInBlock();
-            int lastSentencePos = 0;
-            int nextSentencePos = 0;
 
-            boundaryFinder.setPosition(currentPos);
-            lastSentencePos = boundaryFinder.toPreviousBoundary();
-            boundaryFinder.setPosition(currentPos);
-            nextSentencePos = boundaryFinder.toNextBoundary();
+            // Find the sentence boundaries immediately before and after
+            // the cursor position.
+            //
+            QVector<int>::const_iterator next =
+                std::upper_bound(boundaries.begin(), boundaries.end(), currentPos);
+            QVector<int>::const_iterator previous =
+                std::lower_bound(boundaries.begin(), boundaries.end(), currentPos);
 
-            if (lastSentencePos < 0) {
-                beforeFadedSelection.cursor.movePosition(QTextCursor::StartOfBlock);
-            } else {
-                beforeFadedSelection.cursor.movePosition(QTextCursor::Left, QTextCursor::MoveAnchor, currentPos - lastSentencePos);
-            }
+            focusStart = block.position();
 
-            beforeFadedSelection.cursor.movePosition(QTextCursor::Start, QTextCursor::KeepAnchor);
-            selections.append(beforeFadedSelection);
+            if (previous != boundaries.begin()) {
+                focusStart += *(previous - 1);
+            }
 
-            if (nextSentencePos < 0) {
-                afterFadedSelection.cursor.movePosition(QTextCursor::EndOfBlock);
+            if (next == boundaries.end()) {
+                focusEnd = block.position() + block.length() - 1;
             } else {
-                afterFadedSelection.cursor.movePosition(QTextCursor::Right, QTextCursor::MoveAnchor, nextSentencePos - currentPos);
+                focusEnd = block.position() + *next;
             }
 
-            afterFadedSelection.cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
-            selections.append(afterFadedSelection);
-
             break;
         }
         // `FocusModeTypewriter` implicitly handled here as we don't highlight anything but center the current line.
         default:
+            fade = false;
             break;
         }
 
-        this->setExtraSelections(selections);
+        QList<QTextEdit::ExtraSelection> selections;
+
+        if (fade) {
+            // Only fade the visible text, so that the cost of applying
+            // the selections does not depend on the document size.
+            // The selections are refreshed whenever the editor scrolls.
+            //
+            int visibleStart = 0;
+            int visibleEnd = 0;
+
+            d->visibleRange(visibleStart, visibleEnd);
+
+            if (focusStart > visibleStart) {
+                selections.append
+                (
+                    d->fadedSelection(visibleStart, qMin(focusStart, visibleEnd))
+                );
+            }
+
+            if (focusEnd < visibleEnd) {
+                selections.append
+                (
+                    d->fadedSelection(qMax(focusEnd, visibleStart), visibleEnd)
+                );
+            }
+        }
+
+        this->setExtraSelections(ExtraSelectionLayerFocusMode, selections);
     }
 }
 
@@ -1933,19 +2048,31 @@ void MarkdownEditorPrivate::toggleCursorBlink()
     Q_Q(MarkdownEditor);
     
     this->textCursorVisible = !this->textCursorVisible;
-    q->update();
+
+    // Only repaint the caret itself rather than the entire viewport.
+    q->viewport()->update(caretRect());
 }
 
 void MarkdownEditorPrivate::parseDocument()
 {
     Q_Q(MarkdownEditor);
-    
-    MarkdownAST *ast =
-        CmarkGfmAPI::instance()->parse
-        (
-            q->document()->toPlainText(),
-            false
-        );
+    GW_TRACE_SCOPE("parseDocument", "parser");
+
+    MarkdownAST *ast = nullptr;
+
+    {
+        LatencySample sample(LatencyMonitor::Parse);
+
+        ast = CmarkGfmAPI::instance()->parse
+            (
+                q->document()->toPlainText(),
+                false
+            );
+    }
+
+    if (LatencyMonitor::isEnabled()) {
+        LatencyMonitor::instance()->setNodeCount(ast->nodeCount());
+    }
 
     // Note:  MarkdownDocument is responsible for freeing memory
     // allocated for the AST.
@@ -2409,55 +2536,190 @@ QString MarkdownEditorPrivate::priorMarkdownBlockItemStart
     return QString("");
 }
 
-bool MarkdownEditorPrivate::insideBlockArea(const QTextBlock &block, BlockType &type) const
+TextBlockData *MarkdownEditorPrivate::paintData(QTextBlock block)
 {
-    if (!block.isValid()) {
-        type = BlockTypeNone;
-        return false;
+    Q_Q(MarkdownEditor);
+
+    TextBlockData *blockData = (TextBlockData *) block.userData();
+
+    if (nullptr == blockData) {
+        blockData = new TextBlockData((MarkdownDocument *) q->document(), block);
+        block.setUserData(blockData);
+    }
+
+    int previousState = block.previous().isValid()
+        ? block.previous().userState() : -1;
+
+    if
+    (
+        (blockData->paintRevision == block.revision())
+        && (blockData->paintState == block.userState())
+        && (blockData->paintPreviousState == previousState)
+    ) {
+        return blockData;
     }
 
+    BlockType type = BlockTypeNone;
+
     if (isBlockquote(block)) {
         type = BlockTypeQuote;
-        return true;
+    } else if (isCodeBlock(block)) {
+        type = BlockTypeCode;
     }
 
-    if (isCodeBlock(block)) {
+    blockData->blockAreaType = type;
+
+    if (atCodeBlockStart(block)) {
         type = BlockTypeCode;
-        return true;
+    } else if (isBlockquote(block)) {
+        type = BlockTypeQuote;
+    } else {
+        type = BlockTypeNone;
     }
 
-    type = BlockTypeNone;
-    return false;
+    blockData->blockAreaStartType = type;
+    blockData->rightToLeft = block.text().isRightToLeft();
+    blockData->paintRevision = block.revision();
+    blockData->paintState = block.userState();
+    blockData->paintPreviousState = previousState;
+
+    return blockData;
+}
+
+QRect MarkdownEditorPrivate::caretRect() const
+{
+    Q_Q(const MarkdownEditor);
+
+    // Get the cursor rect so that we have the ideal height for it,
+    // and then set it to be 2 pixels wide.  (The width will be zero,
+    // because we set it to be that in the constructor so that
+    // QPlainTextEdit will not draw another cursor underneath this one.)
+    //
+    QRect r = q->cursorRect();
+    r.setWidth(2);
+    return r;
+}
+
+QPainterPath MarkdownEditorPrivate::clippedBlockAreaPath(const QRectF &rect, qreal radius)
+{
+    QPainterPath path;
+
+    radius = qMin(radius, qMin(rect.width(), rect.height()) / 2);
+
+    if (radius <= 0) {
+        path.addRect(rect);
+        return path;
+    }
+
+    qreal diameter = 2 * radius;
+
+    path.moveTo(rect.topLeft());
+    path.lineTo(rect.topRight());
+    path.lineTo(rect.right(), rect.bottom() - radius);
+    path.arcTo
+    (
+        QRectF(rect.right() - diameter, rect.bottom() - diameter, diameter, diameter),
+        0,
+        -90
+    );
+    path.lineTo(rect.left() + radius, rect.bottom());
+    path.arcTo
+    (
+        QRectF(rect.left(), rect.bottom() - diameter, diameter, diameter),
+        270,
+        -90
+    );
+    path.closeSubpath();
+
+    return path;
+}
+
+const QVector<int> &MarkdownEditorPrivate::sentenceBoundaries(QTextBlock block)
+{
+    TextBlockData *blockData = paintData(block);
+
+    if (blockData->sentenceRevision != block.revision()) {
+        QString text = block.text();
+        QTextBoundaryFinder boundaryFinder(QTextBoundaryFinder::Sentence, text);
+
+        blockData->sentenceBoundaries.clear();
+        blockData->sentenceBoundaries.append(0);
+
+        int boundary = boundaryFinder.toNextBoundary();
+
+        while (boundary > 0) {
+            blockData->sentenceBoundaries.append(boundary);
+            boundary = boundaryFinder.toNextBoundary();
+        }
+
+        blockData->sentenceRevision = block.revision();
+    }
+
+    return blockData->sentenceBoundaries;
+}
+
+void MarkdownEditorPrivate::visibleRange(int &start, int &end) const
+{
+    Q_Q(const MarkdownEditor);
+
+    QRect viewportRect = q->viewport()->rect();
+    QTextBlock firstBlock = q->cursorForPosition(viewportRect.topLeft()).block();
+    QTextBlock lastBlock = q->cursorForPosition(viewportRect.bottomRight()).block();
+
+    start = firstBlock.position();
+    end = lastBlock.position() + lastBlock.length() - 1;
 }
 
-bool MarkdownEditorPrivate::atBlockAreaStart(const QTextBlock &block, BlockType &type) const
+QTextEdit::ExtraSelection MarkdownEditorPrivate::fadedSelection(int start, int end) const
+{
+    Q_Q(const MarkdownEditor);
+
+    QTextEdit::ExtraSelection selection;
+
+    selection.format.setForeground(fadeColor);
+    selection.cursor = QTextCursor(q->document());
+    selection.cursor.setPosition(start);
+    selection.cursor.setPosition(end, QTextCursor::KeepAnchor);
+
+    return selection;
+}
+
+bool MarkdownEditorPrivate::insideBlockArea(const QTextBlock &block, BlockType &type)
 {
     if (!block.isValid()) {
         type = BlockTypeNone;
         return false;
     }
 
-    if (this->atCodeBlockStart(block)) {
-        type = BlockTypeCode;
-        return true;
-    }
+    type = (BlockType) paintData(block)->blockAreaType;
+    return (BlockTypeNone != type);
+}
 
-    if (this->isBlockquote(block)) {
-        type = BlockTypeQuote;
-        return true;
+bool MarkdownEditorPrivate::atBlockAreaStart(const QTextBlock &block, BlockType &type)
+{
+    if (!block.isValid()) {
+        type = BlockTypeNone;
+        return false;
     }
 
-    type = BlockTypeNone;
-    return false;
+    type = (BlockType) paintData(block)->blockAreaStartType;
+    return (BlockTypeNone != type);
 }
 
-bool MarkdownEditorPrivate::atBlockAreaEnd(const QTextBlock &block, const BlockType type) const
+bool MarkdownEditorPrivate::atBlockAreaEnd(const QTextBlock &block, const BlockType type)
 {
+    if (!block.isValid()) {
+        return true;
+    }
+
+    BlockType areaType = (BlockType) paintData(block)->blockAreaType;
+
     switch (type) {
     case BlockTypeCode:
-        return this->atCodeBlockEnd(block) && !this->isBlockquote(block);
+        // Neither a code block nor a blockquote.
+        return (BlockTypeNone == areaType);
     case BlockTypeQuote:
-        return !this->isBlockquote(block);
+        return (BlockTypeQuote != areaType);
     default:
         return true;
     }
@@ -115,6 +115,18 @@ public:
      */
     void setShowTabsAndSpacesEnabled(bool enabled);
 
+    /**
+     * Sets the extra selections of the given layer.  The selections of
+     * all layers are shown together, with later layers drawn over earlier
+     * ones, so that, for example, focus mode does not clear highlighted
+     * find matches.
+     */
+    void setExtraSelections
+    (
+        ExtraSelectionLayer layer,
+        const QList<QTextEdit::ExtraSelection> &selections
+    );
+
     /**
      * Sets up the margins on the sides of the editor, so that the text
      * area is centered in the window.
@@ -48,6 +48,13 @@ enum InterfaceStyle {
     InterfaceStyleSquare,
     InterfaceStyleLast = InterfaceStyleSquare,
 };
+
+enum ExtraSelectionLayer {
+    ExtraSelectionLayerFirst,
+    ExtraSelectionLayerFocusMode = ExtraSelectionLayerFirst,
+    ExtraSelectionLayerFindMatches,
+    ExtraSelectionLayerLast = ExtraSelectionLayerFindMatches
+};
 } // namespace ghostwriter
 
 #endif // MARKDOWNEDITORTYPES_H
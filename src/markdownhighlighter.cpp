@@ -38,9 +38,11 @@
 #include <QStack>
 
 #include "markdownhighlighter.h"
+#include "latencymonitor.h"
 #include "markdownstates.h"
 #include "spelling/dictionary_ref.h"
 #include "spelling/dictionary_manager.h"
+#include "trace.h"
 
 namespace ghostwriter
 {
@@ -127,6 +129,30 @@ MarkdownHighlighter::MarkdownHighlighter
         Qt::QueuedConnection
     );
 
+    // Dictionaries are loaded in the background, so re-check the document
+    // once the real dictionary replaces the fallback.
+    connect
+    (
+        &DictionaryManager::instance(),
+        &DictionaryManager::dictionaryLoaded,
+        this,
+        [this]() {
+            Q_D(MarkdownHighlighter);
+
+            if (d->spellCheckEnabled) {
+                this->rehighlight();
+            }
+        }
+    );
+
+    connect
+    (
+        &DictionaryManager::instance(),
+        &DictionaryManager::personalWordAdded,
+        this,
+        &MarkdownHighlighter::onPersonalWordAdded
+    );
+
     QFont font;
     font.setFamily("Monospace");
     font.setWeight(QFont::Normal);
@@ -158,6 +184,8 @@ MarkdownHighlighter::~MarkdownHighlighter()
 void MarkdownHighlighter::highlightBlock(const QString &text)
 {
     Q_D(MarkdownHighlighter);
+    GW_TRACE_SCOPE("highlightBlock", "highlighter");
+    LatencySample latencySample(LatencyMonitor::HighlightBlock);
 
     int line = currentBlock().blockNumber() + 1;
     int oldState = currentBlock().userState();
@@ -374,10 +402,38 @@ void MarkdownHighlighter::onHighlightBlockAtPosition(int position)
     rehighlightBlock(block);
 }
 
+void MarkdownHighlighter::onPersonalWordAdded(const QString &word)
+{
+    Q_D(MarkdownHighlighter);
+
+    if (!d->spellCheckEnabled || word.isEmpty()) {
+        return;
+    }
+
+    // Words are stored with plain single quotes, but may appear in the
+    // text with typographic ones.
+    QString fancyWord = word;
+    fancyWord.replace(QLatin1Char('\''), QChar(0x2019));
+
+    // Only blocks containing the word can have their spelling errors
+    // change, so leave the rest of the document alone.  The dictionary
+    // also accepts capitalized forms of the word, such as at the start of
+    // a sentence, so match without regard to case.
+    for (QTextBlock block = document()->begin(); block.isValid(); block = block.next()) {
+        const QString text = block.text();
+
+        if (text.contains(word, Qt::CaseInsensitive)
+                || text.contains(fancyWord, Qt::CaseInsensitive)) {
+            rehighlightBlock(block);
+        }
+    }
+}
+
 void MarkdownHighlighterPrivate::spellCheck(const QString &text)
 {
     Q_Q(MarkdownHighlighter);
-    
+    GW_TRACE_SCOPE("spellCheck", "highlighter");
+
     int cursorPosition = editor->textCursor().position();
     QTextBlock cursorPosBlock = q->document()->findBlock(cursorPosition);
     int cursorPosInBlock = -1;
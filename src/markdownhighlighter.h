@@ -138,6 +138,13 @@ public slots:
      */
     void onTypingPaused();
 
+    /**
+     * Signalled by the dictionary manager when a word is added to the
+     * personal dictionary.  Only the text blocks containing the word
+     * are re-highlighted.
+     */
+    void onPersonalWordAdded(const QString &word);
+
     /**
      * Signalled by a text editor when the user changes the text
      * cursor position.  This signal is used to ensure spell
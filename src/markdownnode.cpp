@@ -24,6 +24,8 @@
 
 #include "3rdparty/cmark-gfm/src/cmark-gfm.h"
 #include "3rdparty/cmark-gfm/extensions/cmark-gfm-core-extensions.h"
+#include "3rdparty/cmark-gfm/extensions/strikethrough.h"
+#include "3rdparty/cmark-gfm/extensions/table.h"
 
 #include "markdownnode.h"
 
@@ -308,7 +310,9 @@ bool MarkdownNode::isBulletListItem() const
 
 MarkdownNode::NodeType MarkdownNode::nodeType(cmark_node *node)
 {
-    switch (cmark_node_get_type(node)) {
+    cmark_node_type type = cmark_node_get_type(node);
+
+    switch (type) {
     case CMARK_NODE_DOCUMENT:
         return Document;
     case CMARK_NODE_BLOCK_QUOTE:
@@ -362,15 +366,20 @@ MarkdownNode::NodeType MarkdownNode::nodeType(cmark_node *node)
     case CMARK_NODE_FOOTNOTE_REFERENCE:
         return FootnoteReference;
     default:
-        if (0 == strcmp(cmark_node_get_type_string(node), "table")) {
-            return Table;
-        } else if (0 == strcmp(cmark_node_get_type_string(node), "table_row")) {
-            return TableRow;
-        } else if (0 == strcmp(cmark_node_get_type_string(node), "table_header")) {
-            return TableHeading;
-        } else if (0 == strcmp(cmark_node_get_type_string(node), "table_cell")) {
+        // Extension node types are assigned when the extensions are
+        // registered, so compare against them rather than against type
+        // strings.  Cells come first since large tables are mostly cells.
+        if (CMARK_NODE_TABLE_CELL == type) {
             return TableCell;
-        } else if (0 == strcmp(cmark_node_get_type_string(node), "strikethrough")) {
+        } else if (CMARK_NODE_TABLE_ROW == type) {
+            if (cmark_gfm_extensions_get_table_row_is_header(node)) {
+                return TableHeading;
+            }
+
+            return TableRow;
+        } else if (CMARK_NODE_TABLE == type) {
+            return Table;
+        } else if (CMARK_NODE_STRIKETHROUGH == type) {
             return Strikethrough;
         }
     }
@@ -0,0 +1,288 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QString>
+
+#include "outlinemodel.h"
+
+namespace ghostwriter
+{
+/*
+ * A row of the outline.
+ */
+struct OutlineHeading
+{
+    int level;
+    QString text;
+    int line;
+
+    /*
+    * Returns true if the heading reads the same as the given heading,
+    * regardless of where in the document either of them is.
+    */
+    bool hasSameContent(const OutlineHeading &other) const
+    {
+        return (level == other.level) && (text == other.text);
+    }
+
+    bool operator==(const OutlineHeading &other) const
+    {
+        return hasSameContent(other) && (line == other.line);
+    }
+
+    bool operator!=(const OutlineHeading &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+class OutlineModelPrivate
+{
+    Q_DECLARE_PUBLIC(OutlineModel)
+
+public:
+    OutlineModelPrivate(OutlineModel *q_ptr)
+        : q_ptr(q_ptr)
+    {
+        ;
+    }
+
+    ~OutlineModelPrivate()
+    {
+        ;
+    }
+
+    OutlineModel *q_ptr;
+    QVector<OutlineHeading> rows;
+
+    /*
+    * Emits dataChanged() for the given range of rows, if valid.
+    */
+    void notifyChanged(int first, int last, const QVector<int> &roles);
+};
+
+OutlineModel::OutlineModel(QObject *parent)
+    : QAbstractListModel(parent),
+      d_ptr(new OutlineModelPrivate(this))
+{
+    ;
+}
+
+OutlineModel::~OutlineModel()
+{
+    ;
+}
+
+int OutlineModel::rowCount(const QModelIndex &parent) const
+{
+    Q_D(const OutlineModel);
+
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return d->rows.size();
+}
+
+QVariant OutlineModel::data(const QModelIndex &index, int role) const
+{
+    Q_D(const OutlineModel);
+
+    if (!index.isValid() || (index.row() >= d->rows.size())) {
+        return QVariant();
+    }
+
+    const OutlineHeading &heading = d->rows.at(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole: {
+        QString headingText("   ");
+
+        for (int i = 1; i < heading.level; i++) {
+            headingText += "    ";
+        }
+
+        return headingText + heading.text;
+    }
+    case HeadingTextRole:
+        return heading.text;
+    case HeadingLevelRole:
+        return heading.level;
+    case HeadingLineRole:
+        return heading.line;
+    default:
+        return QVariant();
+    }
+}
+
+void OutlineModel::setHeadings(const QVector<MarkdownNode *> &headings)
+{
+    Q_D(OutlineModel);
+
+    QVector<OutlineHeading> fresh;
+    fresh.reserve(headings.size());
+
+    foreach (MarkdownNode *node, headings) {
+        fresh.append({node->headingLevel(), node->text(), node->startLine()});
+    }
+
+    int oldCount = d->rows.size();
+    int newCount = fresh.size();
+    int common = qMin(oldCount, newCount);
+
+    // Headings before the edit are untouched, including their line numbers.
+    int prefix = 0;
+
+    while ((prefix < common) && (d->rows[prefix] == fresh[prefix])) {
+        prefix++;
+    }
+
+    // Headings after the edit read the same, but may have moved if lines
+    // were added or removed.
+    //
+    int suffix = 0;
+
+    while
+    (
+        (suffix < (common - prefix)) &&
+        d->rows[oldCount - 1 - suffix].hasSameContent(fresh[newCount - 1 - suffix])
+    ) {
+        suffix++;
+    }
+
+    int oldMiddle = oldCount - prefix - suffix;
+    int newMiddle = newCount - prefix - suffix;
+    int replaced = qMin(oldMiddle, newMiddle);
+    int firstChanged = -1;
+    int lastChanged = -1;
+
+    for (int i = prefix; i < (prefix + replaced); i++) {
+        if (d->rows[i] != fresh[i]) {
+            d->rows[i] = fresh[i];
+
+            if (firstChanged < 0) {
+                firstChanged = i;
+            }
+
+            lastChanged = i;
+        }
+    }
+
+    d->notifyChanged(firstChanged, lastChanged, QVector<int>());
+
+    if (newMiddle > oldMiddle) {
+        int first = prefix + replaced;
+        int last = prefix + newMiddle - 1;
+
+        beginInsertRows(QModelIndex(), first, last);
+        d->rows.insert(first, newMiddle - oldMiddle, OutlineHeading());
+
+        for (int i = first; i <= last; i++) {
+            d->rows[i] = fresh[i];
+        }
+
+        endInsertRows();
+    } else if (oldMiddle > newMiddle) {
+        int first = prefix + replaced;
+        int last = prefix + oldMiddle - 1;
+
+        beginRemoveRows(QModelIndex(), first, last);
+        d->rows.remove(first, oldMiddle - newMiddle);
+        endRemoveRows();
+    }
+
+    firstChanged = -1;
+    lastChanged = -1;
+
+    for (int i = newCount - suffix; i < newCount; i++) {
+        if (d->rows[i].line != fresh[i].line) {
+            d->rows[i].line = fresh[i].line;
+
+            if (firstChanged < 0) {
+                firstChanged = i;
+            }
+
+            lastChanged = i;
+        }
+    }
+
+    d->notifyChanged(firstChanged, lastChanged, {HeadingLineRole});
+}
+
+void OutlineModel::clear()
+{
+    Q_D(OutlineModel);
+
+    if (d->rows.isEmpty()) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), 0, d->rows.size() - 1);
+    d->rows.clear();
+    endRemoveRows();
+}
+
+int OutlineModel::headingLine(int row) const
+{
+    Q_D(const OutlineModel);
+
+    if ((row < 0) || (row >= d->rows.size())) {
+        return -1;
+    }
+
+    return d->rows.at(row).line;
+}
+
+int OutlineModel::findHeading(int line) const
+{
+    Q_D(const OutlineModel);
+
+    // Binary search for the first heading starting after the line.
+    int low = 0;
+    int high = d->rows.size();
+
+    while (low < high) {
+        int mid = low + ((high - low) / 2);
+
+        if (d->rows.at(mid).line <= line) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low - 1;
+}
+
+void OutlineModelPrivate::notifyChanged
+(
+    int first,
+    int last,
+    const QVector<int> &roles
+)
+{
+    Q_Q(OutlineModel);
+
+    if ((first < 0) || (last < first)) {
+        return;
+    }
+
+    emit q->dataChanged(q->index(first), q->index(last), roles);
+}
+} // namespace ghostwriter
@@ -0,0 +1,108 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef OUTLINE_MODEL_H
+#define OUTLINE_MODEL_H
+
+#include <QAbstractListModel>
+#include <QScopedPointer>
+#include <QVector>
+
+#include "markdownnode.h"
+
+namespace ghostwriter
+{
+/**
+ * List model of the headings in a Markdown document, in document order.
+ * Each row holds the heading's level, its text as parsed by cmark-gfm,
+ * and the line number on which the heading starts.
+ *
+ * When given a new list of headings, the model compares it against the
+ * rows it already has and emits only the row insertion, removal, and
+ * data change signals needed to bring its views up to date, rather than
+ * resetting.  Typing within the body of a section therefore leaves the
+ * outline untouched.
+ */
+class OutlineModelPrivate;
+class OutlineModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(OutlineModel)
+
+public:
+    /**
+     * Data roles, in addition to Qt::DisplayRole, which holds the heading
+     * text indented according to its level.
+     */
+    enum OutlineRole {
+        HeadingLevelRole = Qt::UserRole + 1,
+        HeadingTextRole,
+        HeadingLineRole
+    };
+
+    /**
+     * Constructor.
+     */
+    OutlineModel(QObject *parent = nullptr);
+
+    /**
+     * Destructor.
+     */
+    virtual ~OutlineModel();
+
+    /**
+     * Returns the number of headings.
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * Returns the data for the given role of the heading at the given index.
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * Updates the model to match the given headings, which must be in
+     * document order (i.e., as returned by MarkdownAST::headings()).
+     */
+    void setHeadings(const QVector<MarkdownNode *> &headings);
+
+    /**
+     * Removes all headings.
+     */
+    void clear();
+
+    /**
+     * Returns the line number (starting from 1) of the heading at the
+     * given row, or -1 if the row is out of range.
+     */
+    int headingLine(int row) const;
+
+    /**
+     * Returns the row of the heading for the section containing the given
+     * line number (starting from 1), that is, the last heading starting on
+     * or before the line.  Returns -1 if the line precedes all headings.
+     */
+    int findHeading(int line) const;
+
+private:
+    QScopedPointer<OutlineModelPrivate> d_ptr;
+};
+} // namespace ghostwriter
+
+#endif // OUTLINE_MODEL_H
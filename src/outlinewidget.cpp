@@ -17,13 +17,14 @@
  *
  ***********************************************************************/
 
-#include <QListWidgetItem>
-#include <QString>
-#include <QTextBlock>
-#include <QVariant>
+#include <QModelIndex>
 #include <QPointer>
+#include <QTextBlock>
 
+#include "outlinemodel.h"
 #include "outlinewidget.h"
+#include "taskscheduler.h"
+#include "trace.h"
 
 namespace ghostwriter
 {
@@ -44,58 +45,62 @@ public:
         ;
     }
 
-    static const int DOCUMENT_POSITION_ROLE;
-
     OutlineWidget *q_ptr;
     QPointer<MarkdownEditor> editor;
+    OutlineModel *model;
+    int refreshJob;
 
     /*
     * Invoked when the user selects one of the headings in the outline
     * in order to navigate to a different position in the document.
     */
-    void onOutlineHeadingSelected(QListWidgetItem *item);
-
-    void reloadOutline();
-
-    /*
-    * Gets the document position stored in the given item.
-    */
-    int documentPosition(QListWidgetItem *item);
+    void onOutlineHeadingSelected(const QModelIndex &index);
 
     /*
-    * Binary search of the outline tree.  Returns row of the matching
-    * QListWidgetItem, or else -1 if the item with the given document
-    * position is not found.
-    *
-    * If exactMatch is false and the item is not found, this method will
-    * return the row number where the heading would belong if it were in
-    * the tree (i.e., an ideal insertion point for a new heading).
+    * Updates the outline model from the document's latest Markdown AST.
     */
-    int findHeading(int position, bool exactMatch = true);
+    void refreshOutline();
 };
 
-const int OutlineWidgetPrivate::DOCUMENT_POSITION_ROLE = Qt::UserRole + 1;
-
 OutlineWidget::OutlineWidget(MarkdownEditor *editor, QWidget *parent)
-    : QListWidget(parent),
+    : QListView(parent),
       d_ptr(new OutlineWidgetPrivate(this, editor))
 {
     Q_D(OutlineWidget);
 
+    d->model = new OutlineModel(this);
+    this->setModel(d->model);
+    this->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    this->setUniformItemSizes(true);
+
+    // Several parses may happen in response to a single user action
+    // (e.g., replacing text across multiple blocks), so let the scheduler
+    // coalesce them into a single refresh.
+    //
+    d->refreshJob = TaskScheduler::instance()->addJob
+        (
+            this,
+            TaskScheduler::SidebarPriority,
+            [d]() {
+                d->refreshOutline();
+                return true;
+            }
+        );
+
     this->connect
     (
         this,
-        &OutlineWidget::itemActivated,
-        [d](QListWidgetItem * item) {
-            d->onOutlineHeadingSelected(item);
+        &OutlineWidget::activated,
+        [d](const QModelIndex &index) {
+            d->onOutlineHeadingSelected(index);
         }
     );
     this->connect
     (
         this,
-        &OutlineWidget::itemClicked,
-        [d](QListWidgetItem * item) {
-            d->onOutlineHeadingSelected(item);
+        &OutlineWidget::clicked,
+        [d](const QModelIndex &index) {
+            d->onOutlineHeadingSelected(index);
         }
     );
     this->connect
@@ -108,10 +113,20 @@ OutlineWidget::OutlineWidget(MarkdownEditor *editor, QWidget *parent)
 
     this->connect
     (
-        editor->document(),
-        &MarkdownDocument::contentsChange,
-        [d](int, int, int) {
-            d->reloadOutline();
+        (MarkdownDocument *) editor->document(),
+        &MarkdownDocument::markdownASTChanged,
+        this,
+        [this, d]() {
+            TaskScheduler *scheduler = TaskScheduler::instance();
+
+            scheduler->setPriority
+            (
+                d->refreshJob,
+                this->isVisible()
+                    ? TaskScheduler::SidebarPriority
+                    : TaskScheduler::HiddenPriority
+            );
+            scheduler->schedule(d->refreshJob);
         }
     );
 }
@@ -128,160 +143,77 @@ void OutlineWidget::updateCurrentNavigationHeading(int position)
     // Make sure editor and document haven't been deleted.
     // Otherwise, application may crash on exit.
     //
-    if (!d->editor) {
+    if (!d->editor || (nullptr == d->editor->document())) {
         return;
     }
 
-    if ((this->count() > 0) && (position >= 0)) {
+    if ((d->model->rowCount() > 0) && (position >= 0)) {
         // Find out in which subsection of the document the cursor presently is
         // located.
         //
-        int row = d->findHeading(position, false);
-
-        // If findHeading call recommended an insertion point for a new
-        // heading rather than a matching row, then back up one row
-        // for the actual heading under which the document position falls.
-        //
-        if
-        (
-            (row == this->count())
-            ||
-            (
-                (row >= 0) &&
-                (row < this->count()) &&
-                (d->documentPosition(this->item(row)) != position)
-            )
-        ) {
-            row--;
-        }
+        QTextBlock block = d->editor->document()->findBlock(position);
+        int row = d->model->findHeading(block.blockNumber() + 1);
 
         if (row >= 0) {
-            QListWidgetItem *itemToHighlight = this->item(row);
-            setCurrentItem(itemToHighlight);
-            this->scrollToItem
+            QModelIndex indexToHighlight = d->model->index(row);
+            setCurrentIndex(indexToHighlight);
+            this->scrollTo
             (
-                itemToHighlight,
+                indexToHighlight,
                 QAbstractItemView::PositionAtCenter
             );
         } else {
             // Document position is before the first heading.  Deselect
             // any selected headings, and scroll to the top.
             //
-            setCurrentItem(nullptr);
+            setCurrentIndex(QModelIndex());
             this->scrollToTop();
         }
     }
 }
 
-void OutlineWidgetPrivate::onOutlineHeadingSelected(QListWidgetItem *item)
+void OutlineWidgetPrivate::onOutlineHeadingSelected(const QModelIndex &index)
 {
     Q_Q(OutlineWidget);
 
     // Make sure editor and document haven't been deleted.
     // Otherwise, application may crash on exit.
     //
-    if (!editor) {
+    if (!editor || (nullptr == editor->document()) || !index.isValid()) {
         return;
     }
 
-    editor->navigateDocument(documentPosition(item));
-    emit q->headingNumberNavigated(q->row(item) + 1);
+    QTextBlock block = editor->document()->findBlockByNumber
+        (
+            model->headingLine(index.row()) - 1
+        );
+
+    if (block.isValid()) {
+        editor->navigateDocument(block.position());
+        emit q->headingNumberNavigated(index.row() + 1);
+    }
 }
 
-void OutlineWidgetPrivate::reloadOutline()
+void OutlineWidgetPrivate::refreshOutline()
 {
     Q_Q(OutlineWidget);
+    GW_TRACE_SCOPE("OutlineWidget::refreshOutline", "outline");
 
     // Make sure editor and document haven't been deleted.
     // Otherwise, application may crash on exit.
     //
-    if (!editor) {
-        return;
-    }
-
-    q->clear();
-
-    if ((nullptr == editor) || (nullptr == editor->document())) {
+    if (!editor || (nullptr == editor->document())) {
         return;
     }
 
     MarkdownAST *ast = ((MarkdownDocument *) editor->document())->markdownAST();
 
     if (nullptr == ast) {
+        model->clear();
         return;
     }
 
-    QVector<MarkdownNode *> headings = ast->headings();
-
-    foreach (MarkdownNode *heading, headings) {
-        QString headingText("   ");
-
-        for (int i = 1; i < heading->headingLevel(); i++) {
-            headingText += "    ";
-        }
-
-        QTextBlock block = editor->document()->findBlockByNumber(heading->startLine() - 1);
-
-        QRegularExpression headingRegex("^\\s*#*(.*?)\\s*#*?\\s*$");
-        QRegularExpressionMatch match = headingRegex.match(block.text());
-
-        if (match.isValid() && match.hasMatch()) {
-            headingText += match.captured(1);
-        }
-
-        if (block.isValid()) {
-            QListWidgetItem *item = new QListWidgetItem();
-            item->setText(headingText);
-            item->setData(DOCUMENT_POSITION_ROLE, QVariant::fromValue(block.position()));
-            q->insertItem(q->count(), item);
-        }
-    }
-
+    model->setHeadings(ast->headings());
     q->updateCurrentNavigationHeading(editor->textCursor().position());
 }
-
-int OutlineWidgetPrivate::documentPosition(QListWidgetItem *item)
-{
-    return item->data(DOCUMENT_POSITION_ROLE).value<int>();
-}
-
-int OutlineWidgetPrivate::findHeading(int position, bool exactMatch)
-{
-    Q_Q(OutlineWidget);
-
-    int low = 0;
-    int high = q->count() - 1;
-    int mid = 0;
-
-    while (low <= high) {
-        mid = low + ((high - low) / 2);
-        int itemPos = documentPosition(q->item(mid));
-
-        // Check if desired heading at document position is at row "mid".
-        if (itemPos == position) {
-            return mid;
-        }
-        // Else if document position is greater than the current item's
-        // position, ignore the first half of the list.
-        //
-        else if (itemPos < position) {
-            mid++;
-            low = mid;
-        }
-        // Else if document position is smaller, ignore the last half of the
-        // list.
-        //
-        else {
-            high = mid - 1;
-        }
-    }
-
-    // Heading with desired document position is not present.
-
-    if (exactMatch) {
-        return -1;
-    } else {
-        return mid;
-    }
-}
 } // namespace ghostwriter
@@ -21,7 +21,7 @@
 #define OUTLINE_WIDGET_H
 
 #include <QScopedPointer>
-#include <QListWidget>
+#include <QListView>
 
 #include "markdowneditor.h"
 
@@ -29,10 +29,12 @@ namespace ghostwriter
 {
 /**
  * Outline widget for use in navigating document headings and displaying the
- * current position in the document to the user.
+ * current position in the document to the user.  The headings are kept in
+ * an OutlineModel, which is refreshed from the document's Markdown AST
+ * whenever the document is parsed.
  */
 class OutlineWidgetPrivate;
-class OutlineWidget : public QListWidget
+class OutlineWidget : public QListView
 {
     Q_OBJECT
     Q_DECLARE_PRIVATE(OutlineWidget)
@@ -31,6 +31,7 @@ public:
 	virtual ~AbstractDictionaryProvider() { }
 
 	virtual bool isValid() const = 0;
+	virtual bool canLoadInBackground() const = 0;
 	virtual QStringList availableDictionaries() const = 0;
 	virtual AbstractDictionary* requestDictionary(const QString& language) const = 0;
 
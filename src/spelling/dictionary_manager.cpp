@@ -30,6 +30,7 @@
 #include <QDir>
 #include <QFile>
 #include <QTextStream>
+#include <QtConcurrentRun>
 
 #include <algorithm>
 
@@ -38,6 +39,15 @@
 namespace
 {
 
+// Maximum number of dictionaries kept loaded in memory.  The least recently
+// requested dictionaries beyond this limit are unloaded, except for the
+// default dictionary.
+const int MAX_LOADED_DICTIONARIES = 4;
+
+// Number of words appended to the personal dictionary file before it is
+// rewritten in sorted order without duplicates.
+const int PERSONAL_COMPACTION_THRESHOLD = 100;
+
 bool compareWords(const QString& s1, const QString& s2)
 {
 	return s1.localeAwareCompare(s2) < 0;
@@ -73,7 +83,9 @@ public:
 
 	void addToPersonal(const QString& word)
 	{
-		Q_UNUSED(word);
+		// Stands in for dictionaries that are still loading, so the word
+		// must not be lost.
+		DictionaryManager::instance().add(word);
 	}
 
 	void addToSession(const QStringList& words)
@@ -92,6 +104,18 @@ private:
 	}
 };
 
+AbstractDictionary* createDictionary(const QList<AbstractDictionaryProvider*>& providers, const QString& language)
+{
+	foreach (AbstractDictionaryProvider* provider, providers) {
+		AbstractDictionary* dictionary = provider->requestDictionary(language);
+		if (dictionary && dictionary->isValid()) {
+			return dictionary;
+		}
+		delete dictionary;
+	}
+	return 0;
+}
+
 }
 
 QString DictionaryManager::m_path;
@@ -132,14 +156,44 @@ QString DictionaryManager::availableDictionary(const QString& language) const
 
 //-----------------------------------------------------------------------------
 
+QStringList DictionaryManager::personal() const
+{
+	QStringList words = m_personal.values();
+	std::sort(words.begin(), words.end(), compareWords);
+	return words;
+}
+
+//-----------------------------------------------------------------------------
+
 void DictionaryManager::add(const QString& word)
 {
-	QStringList words = personal();
-    if (words.contains(word)) {
+	if (m_personal.contains(word)) {
 		return;
 	}
-	words.append(word);
-	setPersonal(words);
+	m_personal.insert(word);
+
+	// Append the new word rather than rewriting the whole file, and only
+	// compact the file once enough words have accumulated.
+	m_personal_appended++;
+	if (m_personal_appended >= PERSONAL_COMPACTION_THRESHOLD) {
+		writePersonal();
+	} else {
+		QFile file(m_path + "/personal");
+		if (file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+			QTextStream stream(&file);
+			stream.setCodec("UTF-8");
+			stream << word << "\n";
+		}
+	}
+
+	// Add only the new word to the loaded dictionaries
+	QStringList words(word);
+	foreach (AbstractDictionary* dictionary, m_dictionaries) {
+		dictionary->addToSession(words);
+	}
+
+	// Re-check text containing the word
+	emit personalWordAdded(word);
 }
 
 //-----------------------------------------------------------------------------
@@ -257,31 +311,25 @@ void DictionaryManager::setPath(const QString& path)
 void DictionaryManager::setPersonal(const QStringList& words)
 {
 	// Check if new
-    QStringList personal = words;
-	std::sort(personal.begin(), personal.end(), compareWords);
+	QSet<QString> personal = words.toSet();
 	if (personal == m_personal) {
 		return;
 	}
 
 	// Remove current personal dictionary
+	QStringList session = m_personal.values();
 	foreach (AbstractDictionary* dictionary, m_dictionaries) {
-		dictionary->removeFromSession(m_personal);
+		dictionary->removeFromSession(session);
 	}
 
 	// Update and store personal dictionary
 	m_personal = personal;
-	QFile file(m_path + "/personal");
-	if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-		QTextStream stream(&file);
-		stream.setCodec("UTF-8");
-		foreach (const QString& word, m_personal) {
-			stream << word << "\n";
-		}
-	}
+	writePersonal();
 
 	// Add personal dictionary
+	session = m_personal.values();
 	foreach (AbstractDictionary* dictionary, m_dictionaries) {
-		dictionary->addToSession(m_personal);
+		dictionary->addToSession(session);
 	}
 
 	// Re-check documents
@@ -290,7 +338,8 @@ void DictionaryManager::setPersonal(const QStringList& words)
 
 //-----------------------------------------------------------------------------
 
-DictionaryManager::DictionaryManager()
+DictionaryManager::DictionaryManager() :
+	m_personal_appended(0)
 {
 	addProviders();
 
@@ -299,10 +348,17 @@ DictionaryManager::DictionaryManager()
 	if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
 		QTextStream stream(&file);
 		stream.setCodec("UTF-8");
+		int count = 0;
 		while (!stream.atEnd()) {
-			m_personal.append(stream.readLine());
+			QString word = stream.readLine();
+			if (!word.isEmpty()) {
+				m_personal.insert(word);
+				count++;
+			}
 		}
-		std::sort(m_personal.begin(), m_personal.end(), compareWords);
+
+		// Count duplicate entries towards the next compaction
+		m_personal_appended = count - m_personal.size();
 	}
 }
 
@@ -310,8 +366,18 @@ DictionaryManager::DictionaryManager()
 
 DictionaryManager::~DictionaryManager()
 {
+	foreach (QFutureWatcher<AbstractDictionary*>* watcher, m_loading) {
+		watcher->disconnect(this);
+		watcher->waitForFinished();
+		delete watcher->result();
+		delete watcher;
+	}
+	m_loading.clear();
+
 	foreach (AbstractDictionary* dictionary, m_dictionaries) {
-		delete dictionary;
+		if (dictionary != *DictionaryFallback::instance()) {
+			delete dictionary;
+		}
 	}
 	m_dictionaries.clear();
 
@@ -335,25 +401,130 @@ void DictionaryManager::addProvider(AbstractDictionaryProvider* provider)
 
 AbstractDictionary** DictionaryManager::requestDictionaryData(const QString& language)
 {
+	// Until the dictionary has finished loading in the background, the
+	// fallback dictionary is used in its place.  Since dictionary references
+	// point at the slot rather than at the dictionary itself, they pick up
+	// the real dictionary once it is installed.
 	if (!m_dictionaries.contains(language)) {
-		AbstractDictionary* dictionary = 0;
-		foreach (AbstractDictionaryProvider* provider, m_providers) {
-			dictionary = provider->requestDictionary(language);
-			if (dictionary && dictionary->isValid()) {
-				break;
-			} else {
-				delete dictionary;
-				dictionary = 0;
+		m_dictionaries[language] = *DictionaryFallback::instance();
+	}
+
+	if ((m_dictionaries.value(language) == *DictionaryFallback::instance())
+			&& !m_loading.contains(language)) {
+		loadDictionary(language);
+	}
+
+	m_recent.removeAll(language);
+	m_recent.prepend(language);
+
+	return &m_dictionaries[language];
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::loadDictionary(const QString& language)
+{
+	QList<AbstractDictionaryProvider*> background;
+	QList<AbstractDictionaryProvider*> foreground;
+
+	foreach (AbstractDictionaryProvider* provider, m_providers) {
+		if (provider->canLoadInBackground()) {
+			background.append(provider);
+		} else {
+			foreground.append(provider);
+		}
+	}
+
+	if (background.isEmpty()) {
+		installDictionary(language, createDictionary(foreground, language));
+		return;
+	}
+
+	QFutureWatcher<AbstractDictionary*>* watcher = new QFutureWatcher<AbstractDictionary*>(this);
+	m_loading.insert(language, watcher);
+
+	connect(watcher, &QFutureWatcher<AbstractDictionary*>::finished, this,
+		[this, watcher, language, foreground]() {
+			AbstractDictionary* dictionary = watcher->result();
+
+			m_loading.remove(language);
+			watcher->deleteLater();
+
+			// Try the providers that must be loaded on this thread if none
+			// of the others had a matching dictionary.
+			if (!dictionary) {
+				dictionary = createDictionary(foreground, language);
 			}
+
+			installDictionary(language, dictionary);
+		});
+
+	watcher->setFuture(QtConcurrent::run(createDictionary, background, language));
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::installDictionary(const QString& language, AbstractDictionary* dictionary)
+{
+	if (!dictionary) {
+		return;
+	}
+
+	dictionary->addToSession(m_personal.values());
+	m_dictionaries[language] = dictionary;
+
+	if (language == m_default_language) {
+		m_default_dictionary = dictionary;
+	}
+
+	evictDictionaries();
+
+	// Re-check documents
+	emit dictionaryLoaded(language);
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::evictDictionaries()
+{
+	AbstractDictionary* fallback = *DictionaryFallback::instance();
+	int loaded = 0;
+
+	foreach (AbstractDictionary* dictionary, m_dictionaries) {
+		if (dictionary != fallback) {
+			loaded++;
 		}
+	}
+
+	for (int i = m_recent.size() - 1; (i >= 0) && (loaded > MAX_LOADED_DICTIONARIES); i--) {
+		const QString language = m_recent.at(i);
+		AbstractDictionary* dictionary = m_dictionaries.value(language, fallback);
 
-		if (!dictionary) {
-			return DictionaryFallback::instance();
+		if ((language == m_default_language) || (dictionary == fallback)) {
+			continue;
 		}
-		dictionary->addToSession(m_personal);
-		m_dictionaries[language] = dictionary;
+
+		// Keep the slot so that outstanding references fall back gracefully.
+		delete dictionary;
+		m_dictionaries[language] = fallback;
+		m_recent.removeAt(i);
+		loaded--;
 	}
-	return &m_dictionaries[language];
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::writePersonal()
+{
+	QFile file(m_path + "/personal");
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		QTextStream stream(&file);
+		stream.setCodec("UTF-8");
+		foreach (const QString& word, personal()) {
+			stream << word << "\n";
+		}
+	}
+	m_personal_appended = 0;
 }
 
 //-----------------------------------------------------------------------------
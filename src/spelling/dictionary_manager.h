@@ -24,8 +24,10 @@ class AbstractDictionary;
 class AbstractDictionaryProvider;
 class DictionaryRef;
 
+#include <QFutureWatcher>
 #include <QHash>
 #include <QObject>
+#include <QSet>
 #include <QStringList>
 
 class DictionaryManager : public QObject
@@ -54,6 +56,8 @@ public:
 
 signals:
 	void changed();
+	void dictionaryLoaded(const QString& language);
+	void personalWordAdded(const QString& word);
 
 private:
 	DictionaryManager();
@@ -61,14 +65,21 @@ private:
 
 	void addProvider(AbstractDictionaryProvider* provider);
 	AbstractDictionary** requestDictionaryData(const QString& language);
+	void loadDictionary(const QString& language);
+	void installDictionary(const QString& language, AbstractDictionary* dictionary);
+	void evictDictionaries();
+	void writePersonal();
 
 private:
 	QList<AbstractDictionaryProvider*> m_providers;
 	QHash<QString, AbstractDictionary*> m_dictionaries;
+	QHash<QString, QFutureWatcher<AbstractDictionary*>*> m_loading;
+	QStringList m_recent;
 	AbstractDictionary* m_default_dictionary;
 
 	QString m_default_language;
-	QStringList m_personal;
+	QSet<QString> m_personal;
+	int m_personal_appended;
 
 	static QString m_path;
 };
@@ -83,9 +94,4 @@ inline QString DictionaryManager::path()
 	return m_path;
 }
 
-inline QStringList DictionaryManager::personal() const
-{
-	return m_personal;
-}
-
 #endif
@@ -35,6 +35,11 @@ public:
 		return true;
 	}
 
+	bool canLoadInBackground() const
+	{
+		return true;
+	}
+
 	QStringList availableDictionaries() const;
 	AbstractDictionary* requestDictionary(const QString& language) const;
 
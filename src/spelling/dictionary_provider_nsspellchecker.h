@@ -33,6 +33,11 @@ public:
 		return true;
 	}
 
+	bool canLoadInBackground() const
+	{
+		return false;
+	}
+
 	QStringList availableDictionaries() const;
 	AbstractDictionary* requestDictionary(const QString& language) const;
 
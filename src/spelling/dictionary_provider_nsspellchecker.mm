@@ -163,7 +163,16 @@ void DictionaryNSSpellChecker::addToSession(const QStringList& words)
 {
 	NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
 
-	[[NSSpellChecker sharedSpellChecker] setIgnoredWords:convertList(words) inSpellDocumentWithTag:m_tag];
+	// Merge with the words already in the session, since words may be
+	// added one at a time.
+	NSArray* array = [[NSSpellChecker sharedSpellChecker] ignoredWordsInSpellDocumentWithTag:m_tag];
+	if (array) {
+		array = [array arrayByAddingObjectsFromArray:convertList(words)];
+	} else {
+		array = convertList(words);
+	}
+
+	[[NSSpellChecker sharedSpellChecker] setIgnoredWords:array inSpellDocumentWithTag:m_tag];
 
 	[pool release];
 }
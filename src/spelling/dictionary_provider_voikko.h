@@ -31,6 +31,12 @@ public:
 	DictionaryProviderVoikko();
 
 	bool isValid() const;
+
+	bool canLoadInBackground() const
+	{
+		return false;
+	}
+
 	QStringList availableDictionaries() const;
 	AbstractDictionary* requestDictionary(const QString& language) const;
 
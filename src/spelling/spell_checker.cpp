@@ -72,13 +72,9 @@ void SpellChecker::suggestionChanged(QListWidgetItem* suggestion)
 
 void SpellChecker::add()
 {
+    // The highlighter re-checks the blocks containing the added word.
     m_dictionary.addToPersonal(m_word);
 
-    if (nullptr != m_spelling_highlighter)
-    {
-        m_spelling_highlighter->rehighlight();
-    }
-
 	ignore();
 }
 
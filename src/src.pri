@@ -0,0 +1,170 @@
+################################################################################
+#
+# Copyright (C) 2022 wereturtle
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+################################################################################
+
+# Sources shared by the application and the benchmarks.  appmain.cpp is
+# left out so that each can provide its own main().
+
+macx {
+    LIBS += -framework AppKit
+
+    HEADERS += $$PWD/spelling/dictionary_provider_nsspellchecker.h
+
+    OBJECTIVE_SOURCES += $$PWD/spelling/dictionary_provider_nsspellchecker.mm
+} else:win32 {
+    include($$PWD/../3rdparty/hunspell/hunspell.pri)
+
+    HEADERS += $$PWD/spelling/dictionary_provider_hunspell.h \
+        $$PWD/spelling/dictionary_provider_voikko.h
+
+    SOURCES += $$PWD/spelling/dictionary_provider_hunspell.cpp \
+        $$PWD/spelling/dictionary_provider_voikko.cpp
+
+} else:unix {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += hunspell
+    
+    HEADERS += $$PWD/spelling/dictionary_provider_hunspell.h \
+        $$PWD/spelling/dictionary_provider_voikko.h
+
+    SOURCES += $$PWD/spelling/dictionary_provider_hunspell.cpp \
+        $$PWD/spelling/dictionary_provider_voikko.cpp
+}
+
+INCLUDEPATH += $$PWD/.. $$PWD $$PWD/spelling
+
+HEADERS += \
+    $$PWD/abstractstatisticswidget.h \
+    $$PWD/appsettings.h \
+    $$PWD/batchexporter.h \
+    $$PWD/cmarkgfmapi.h \
+    $$PWD/cmarkgfmexporter.h \
+    $$PWD/colorscheme.h \
+    $$PWD/colorschemepreviewer.h \
+    $$PWD/commandlineexporter.h \
+    $$PWD/documenthistory.h \
+    $$PWD/documentmanager.h \
+    $$PWD/documentstatistics.h \
+    $$PWD/documentstatisticswidget.h \
+    $$PWD/exportdialog.h \
+    $$PWD/exporter.h \
+    $$PWD/exporterfactory.h \
+    $$PWD/exportformat.h \
+    $$PWD/htmlpreview.h \
+    $$PWD/latencyindicator.h \
+    $$PWD/lazyhtmlpreview.h \
+    $$PWD/latencymonitor.h \
+    $$PWD/localedialog.h \
+    $$PWD/mainwindow.h \
+    $$PWD/markdowndocument.h \
+    $$PWD/markdowneditor.h \
+    $$PWD/markdowneditortypes.h \
+    $$PWD/markdownhighlighter.h \
+    $$PWD/markdownast.h \
+    $$PWD/markdownnode.h \
+    $$PWD/markdownstates.h \
+    $$PWD/memoryarena.h \
+    $$PWD/messageboxhelper.h \
+    $$PWD/outlinemodel.h \
+    $$PWD/outlinewidget.h \
+    $$PWD/preferencesdialog.h \
+    $$PWD/previewoptionsdialog.h \
+    $$PWD/sandboxedwebpage.h \
+    $$PWD/sessionstatistics.h \
+    $$PWD/sessionstatisticswidget.h \
+    $$PWD/sidebar.h \
+    $$PWD/simplefontdialog.h \
+    $$PWD/statisticsindicator.h \
+    $$PWD/dictionaryindicator.h \
+    $$PWD/stringobserver.h \
+    $$PWD/stylesheetbuilder.h \
+    $$PWD/taskscheduler.h \
+    $$PWD/textblockdata.h \
+    $$PWD/theme.h \
+    $$PWD/themeeditordialog.h \
+    $$PWD/themerepository.h \
+    $$PWD/themeselectiondialog.h \
+    $$PWD/timelabel.h \
+    $$PWD/trace.h \
+    $$PWD/findreplace.h \
+    $$PWD/findinfolderdialog.h \
+    $$PWD/foldersearch.h \
+    $$PWD/textmatcher.h \
+    $$PWD/color_button.h \
+    $$PWD/spelling/abstract_dictionary.h \
+    $$PWD/spelling/abstract_dictionary_provider.h \
+    $$PWD/spelling/dictionary_manager.h \
+    $$PWD/spelling/dictionary_ref.h \
+    $$PWD/spelling/spell_checker.h
+
+SOURCES += \
+    $$PWD/abstractstatisticswidget.cpp \
+    $$PWD/appsettings.cpp \
+    $$PWD/batchexporter.cpp \
+    $$PWD/cmarkgfmapi.cpp \
+    $$PWD/cmarkgfmexporter.cpp \
+    $$PWD/colorschemepreviewer.cpp \
+    $$PWD/commandlineexporter.cpp \
+    $$PWD/documenthistory.cpp \
+    $$PWD/documentmanager.cpp \
+    $$PWD/documentstatistics.cpp \
+    $$PWD/documentstatisticswidget.cpp \
+    $$PWD/exportdialog.cpp \
+    $$PWD/exporter.cpp \
+    $$PWD/exporterfactory.cpp \
+    $$PWD/exportformat.cpp \
+    $$PWD/htmlpreview.cpp \
+    $$PWD/latencyindicator.cpp \
+    $$PWD/lazyhtmlpreview.cpp \
+    $$PWD/latencymonitor.cpp \
+    $$PWD/localedialog.cpp \
+    $$PWD/mainwindow.cpp \
+    $$PWD/markdowndocument.cpp \
+    $$PWD/markdowneditor.cpp \
+    $$PWD/markdownhighlighter.cpp \
+    $$PWD/markdownast.cpp \
+    $$PWD/markdownnode.cpp \
+    $$PWD/memoryarena.cpp \
+    $$PWD/messageboxhelper.cpp \
+    $$PWD/outlinemodel.cpp \
+    $$PWD/outlinewidget.cpp \
+    $$PWD/preferencesdialog.cpp \
+    $$PWD/previewoptionsdialog.cpp \
+    $$PWD/sandboxedwebpage.cpp \
+    $$PWD/sessionstatistics.cpp \
+    $$PWD/sessionstatisticswidget.cpp \
+    $$PWD/sidebar.cpp \
+    $$PWD/simplefontdialog.cpp \
+    $$PWD/statisticsindicator.cpp \
+    $$PWD/dictionaryindicator.cpp \
+    $$PWD/stringobserver.cpp \
+    $$PWD/stylesheetbuilder.cpp \
+    $$PWD/taskscheduler.cpp \
+    $$PWD/theme.cpp \
+    $$PWD/themeeditordialog.cpp \
+    $$PWD/themerepository.cpp \
+    $$PWD/themeselectiondialog.cpp \
+    $$PWD/timelabel.cpp \
+    $$PWD/trace.cpp \
+    $$PWD/color_button.cpp \
+    $$PWD/findreplace.cpp \
+    $$PWD/findinfolderdialog.cpp \
+    $$PWD/foldersearch.cpp \
+    $$PWD/textmatcher.cpp \
+    $$PWD/spelling/dictionary_manager.cpp \
+    $$PWD/spelling/spell_checker.cpp
@@ -18,6 +18,7 @@
  ***********************************************************************/
 
 #include <QListView>
+#include <QVector>
 
 #include "statisticsindicator.h"
 
@@ -37,12 +38,69 @@ static QString writeTimeText(int minutes) { return StatisticsIndicator::tr("%1:%
                                                         .arg((int) (minutes / 60), 2, 10, QChar('0'))
                                                         .arg((int) (minutes % 60), 2, 10, QChar('0')); }
 
+class StatisticsIndicatorPrivate
+{
+    Q_DECLARE_PUBLIC(StatisticsIndicator)
+
+public:
+    // Statistics that can be displayed, in the order of the combo box items.
+    enum Statistic {
+        WordCount,
+        CharacterCount,
+        SentenceCount,
+        ParagraphCount,
+        PageCount,
+        ReadingTime,
+        WordsAdded,
+        WordsPerMinute,
+        WritingTime,
+        StatisticCount
+    };
+
+    StatisticsIndicatorPrivate(StatisticsIndicator *q_ptr)
+        : q_ptr(q_ptr),
+          values(StatisticCount, 0),
+          stale(StatisticCount, false)
+    {
+        ;
+    }
+
+    ~StatisticsIndicatorPrivate()
+    {
+        ;
+    }
+
+    StatisticsIndicator *q_ptr;
+
+    // Latest value of each statistic, and whether its item text is out
+    // of date.
+    //
+    QVector<int> values;
+    QVector<bool> stale;
+
+    /*
+    * Stores the new value of the statistic.  Only the item currently shown
+    * in the status bar is updated right away; the others are updated when
+    * they are next shown.
+    */
+    void setValue(Statistic statistic, int value);
+
+    /*
+    * Updates the item text of the given statistic, if it is out of date.
+    */
+    void refreshItem(int statistic);
+
+    static QString text(int statistic, int value);
+};
 
 StatisticsIndicator::StatisticsIndicator(DocumentStatistics *documentStats,
         SessionStatistics *sessionStats,
         QWidget *parent)
-    : QComboBox(parent)
+    : QComboBox(parent),
+      d_ptr(new StatisticsIndicatorPrivate(this))
 {
+    Q_D(StatisticsIndicator);
+
     this->setView(new QListView());
     this->view()->setTextElideMode(Qt::ElideNone);
     this->setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLength);
@@ -55,141 +113,48 @@ StatisticsIndicator::StatisticsIndicator(DocumentStatistics *documentStats,
             this->setMinimumContentsLength(text.length());
         });
 
+    for (int i = 0; i < StatisticsIndicatorPrivate::StatisticCount; i++) {
+        this->addItem(d->text(i, 0));
+        this->setItemData(i, Qt::AlignCenter, Qt::TextAlignmentRole);
+    }
 
-    int index = 0;
-
-    this->addItem(wordCountText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
-    this->connect(documentStats,
-        &DocumentStatistics::wordCountChanged,
-        this,
-        [this, index](int value) {
-            this->setItemText(index,
-                wordCountText(value));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
-        });
-    index++;
-
-    this->addItem(characterCountText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
-    this->connect(documentStats,
-        &DocumentStatistics::characterCountChanged,
-        this,
-        [this, index](int value) {
-            this->setItemText(index,
-                characterCountText(value));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
-        });
-    index++;
-
-    this->addItem(sentenceCountText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
-    this->connect(documentStats,
-        &DocumentStatistics::sentenceCountChanged,
-        this,
-        [this, index](int value) {
-            this->setItemText(index,
-                sentenceCountText(value));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
-        });
-    index++;
-
-    this->addItem(paragraphCountText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
-    this->connect(documentStats,
-        &DocumentStatistics::paragraphCountChanged,
-        this,
-        [this, index](int value) {
-            this->setItemText(index,
-                paragraphCountText(value));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
-        });
-    index++;
-
-    this->addItem(pageCountText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
-    this->connect(documentStats,
-        &DocumentStatistics::pageCountChanged,
-        this,
-        [this, index](int value) {
-            this->setItemText(index,
-                pageCountText(value));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
+    connect(this,
+        QOverload<int>::of(&QComboBox::currentIndexChanged),
+        [d](int index) {
+            d->refreshItem(index);
         });
-    index++;
 
-    this->addItem(readTimeText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
     this->connect(documentStats,
-        &DocumentStatistics::readingTimeChanged,
+        &DocumentStatistics::statisticsChanged,
         this,
-        [this, index](int minutes) {
-            this->setItemText(index,
-                readTimeText(minutes));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
+        [d](const DocumentStatisticsSnapshot &statistics) {
+            d->setValue(StatisticsIndicatorPrivate::WordCount, statistics.wordCount);
+            d->setValue(StatisticsIndicatorPrivate::CharacterCount, statistics.characterCount);
+            d->setValue(StatisticsIndicatorPrivate::SentenceCount, statistics.sentenceCount);
+            d->setValue(StatisticsIndicatorPrivate::ParagraphCount, statistics.paragraphCount);
+            d->setValue(StatisticsIndicatorPrivate::PageCount, statistics.pageCount);
+            d->setValue(StatisticsIndicatorPrivate::ReadingTime, statistics.readingTime);
         });
-    index++;
 
-    this->addItem(wordsAddedText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
     this->connect(sessionStats,
         &SessionStatistics::wordCountChanged,
         this,
-        [this, index](int value) {
-            this->setItemText(index,
-                wordsAddedText(value));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
+        [d](int value) {
+            d->setValue(StatisticsIndicatorPrivate::WordsAdded, value);
         });
-    index++;
 
-    this->addItem(wpmText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
     this->connect(sessionStats,
         &SessionStatistics::wordsPerMinuteChanged,
         this,
-        [this, index](int value) {
-            this->setItemText(index,
-                wpmText(value));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
+        [d](int value) {
+            d->setValue(StatisticsIndicatorPrivate::WordsPerMinute, value);
         });
-    index++;
 
-    this->addItem(writeTimeText(0));
-    this->setItemData(index, Qt::AlignCenter, Qt::TextAlignmentRole);
     this->connect(sessionStats,
         &SessionStatistics::writingTimeChanged,
         this,
-        [this, index](int minutes) {
-            this->setItemText(index,
-                writeTimeText(minutes));
-
-            if (index == this->currentIndex()) {
-                this->setMinimumContentsLength(this->itemText(index).length());
-            }
+        [d](int minutes) {
+            d->setValue(StatisticsIndicatorPrivate::WritingTime, minutes);
         });
 }
 
@@ -200,9 +165,13 @@ StatisticsIndicator::~StatisticsIndicator()
 
 void StatisticsIndicator::showPopup()
 {
+    Q_D(StatisticsIndicator);
+
     int max = 0;
 
     for (int i = 0; i < this->count(); i++) {
+        d->refreshItem(i);
+
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 11, 0))
         int itemWidth = this->fontMetrics().horizontalAdvance(this->itemText(i));
 #else
@@ -218,4 +187,62 @@ void StatisticsIndicator::showPopup()
     QComboBox::showPopup();
 }
 
+void StatisticsIndicatorPrivate::setValue(Statistic statistic, int value)
+{
+    Q_Q(StatisticsIndicator);
+
+    if (value == values[statistic]) {
+        return;
+    }
+
+    values[statistic] = value;
+    stale[statistic] = true;
+
+    if (statistic == q->currentIndex()) {
+        refreshItem(statistic);
+    }
+}
+
+void StatisticsIndicatorPrivate::refreshItem(int statistic)
+{
+    Q_Q(StatisticsIndicator);
+
+    if ((statistic < 0) || (statistic >= StatisticCount) || !stale[statistic]) {
+        return;
+    }
+
+    stale[statistic] = false;
+    q->setItemText(statistic, text(statistic, values[statistic]));
+
+    if (statistic == q->currentIndex()) {
+        q->setMinimumContentsLength(q->itemText(statistic).length());
+    }
+}
+
+QString StatisticsIndicatorPrivate::text(int statistic, int value)
+{
+    switch (statistic) {
+    case WordCount:
+        return wordCountText(value);
+    case CharacterCount:
+        return characterCountText(value);
+    case SentenceCount:
+        return sentenceCountText(value);
+    case ParagraphCount:
+        return paragraphCountText(value);
+    case PageCount:
+        return pageCountText(value);
+    case ReadingTime:
+        return readTimeText(value);
+    case WordsAdded:
+        return wordsAddedText(value);
+    case WordsPerMinute:
+        return wpmText(value);
+    case WritingTime:
+        return writeTimeText(value);
+    default:
+        return QString();
+    }
+}
+
 }
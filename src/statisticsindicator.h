@@ -21,6 +21,7 @@
 #define STATISTICSINDICATOR_H
 
 #include <QComboBox>
+#include <QScopedPointer>
 
 #include "documentstatistics.h"
 #include "sessionstatistics.h"
@@ -32,9 +33,11 @@ namespace ghostwriter
  * widget allows the user to select one document/session statistics to display
  * at a time in the status bar.
  */
+class StatisticsIndicatorPrivate;
 class StatisticsIndicator : public QComboBox
 {
     Q_OBJECT
+    Q_DECLARE_PRIVATE(StatisticsIndicator)
 
 public:
     /**
@@ -51,6 +54,8 @@ public:
 
     void showPopup();
 
+private:
+    QScopedPointer<StatisticsIndicatorPrivate> d_ptr;
 };
 }
 
@@ -21,7 +21,7 @@
 #include <QDir>
 #include <QFile>
 #include <QPalette>
-#include <QRegularExpression>
+#include <QStringList>
 #include <QTextStream>
 #include <QDebug>
 #include <QTemporaryFile>
@@ -33,17 +33,33 @@
 namespace ghostwriter
 {
 
-QString StyleSheetBuilder::m_statIndicatorArrowIconPath = QString();
+QHash<QString, QString> StyleSheetBuilder::m_statIndicatorArrowIconPaths;
 
-QString StyleSheetBuilder::m_htmlPreviewSass;
+// Only a handful of themes are in play at once (typically the light and
+// dark variants of the current one), so keep just the most recent few.
+QCache<QString, StyleSheetBuilder> StyleSheetBuilder::m_memoizedBuilders(8);
+
+QVector<StyleSheetBuilder::CssSegment> StyleSheetBuilder::m_htmlPreviewTemplate;
 
 StyleSheetBuilder::StyleSheetBuilder(const ColorScheme &colors,
         const bool roundedCorners,
         const QFont& previewTextFont,
         const QFont& previewCodeFont)
 {
-    QString styleSheet;
-    QTextStream stream(&styleSheet);
+    QString key = memoizationKey
+        (
+            colors,
+            roundedCorners,
+            previewTextFont,
+            previewCodeFont
+        );
+
+    StyleSheetBuilder *memoized = m_memoizedBuilders.object(key);
+
+    if (nullptr != memoized) {
+        *this = *memoized;
+        return;
+    }
 
     this->m_htmlPreviewTextFont = previewTextFont;
     this->m_htmlPreviewCodeFont = previewCodeFont;
@@ -97,24 +113,8 @@ StyleSheetBuilder::StyleSheetBuilder(const ColorScheme &colors,
     this->m_blockquoteColor = colors.blockquoteText.name();
     this->m_thickBorderColor = colors.emphasisMarkup.name();
 
-    // Remove previous cache/temporary files.
-    clearCache();
-
-    // Refresh statistics indicator drop-down arrow icon.
-    this->m_awesome = new QtAwesome();
-    this->m_awesome->initFontAwesome();
-    QVariantMap options;
-    options.insert("color", this->m_interfaceTextColor);
-    QIcon statIndicatorIcon = this->m_awesome->icon(style::stfas, fa::chevroncircleup, options);
-
-    QTemporaryFile tempIconFile(QDir::tempPath() + "/XXXXXX.png");
-    tempIconFile.setAutoRemove(false);
-
-    if (tempIconFile.open()) {
-        m_statIndicatorArrowIconPath = tempIconFile.fileName();
-        statIndicatorIcon.pixmap(16, 16).save(&tempIconFile, "PNG");
-        tempIconFile.close();
-    }
+    this->m_awesome = QtAwesome::instance();
+    buildStatIndicatorArrowIcon();
 
     // Create the style sheets.
     buildScrollBarStyleSheet(roundedCorners);
@@ -128,6 +128,8 @@ StyleSheetBuilder::StyleSheetBuilder(const ColorScheme &colors,
     buildSidebarWidgetStyleSheet();
     buildStatusLabelStyleSheet();
     buildHtmlPreviewCss(roundedCorners);
+
+    m_memoizedBuilders.insert(key, new StyleSheetBuilder(*this));
 }
 
 
@@ -138,14 +140,20 @@ StyleSheetBuilder::~StyleSheetBuilder()
 
 void StyleSheetBuilder::clearCache()
 {
-    // Remove previous cache/temporary file of statistics indicator drop-down arrow icon.
-    if (!m_statIndicatorArrowIconPath.isNull() && !m_statIndicatorArrowIconPath.isEmpty()) {
-        QFile iconFile(m_statIndicatorArrowIconPath);
+    // Remove the cache/temporary files of the statistics indicator
+    // drop-down arrow icons.  The memoized style sheets refer to them,
+    // so they have to go too.
+    //
+    foreach (const QString &iconPath, m_statIndicatorArrowIconPaths) {
+        QFile iconFile(iconPath);
 
         if (iconFile.exists()) {
             iconFile.remove();
         }
     }
+
+    m_statIndicatorArrowIconPaths.clear();
+    m_memoizedBuilders.clear();
 }
 
 QString StyleSheetBuilder::layoutStyleSheet()
@@ -524,26 +532,28 @@ void StyleSheetBuilder::buildSidebarWidgetStyleSheet()
     QTextStream stream(&m_sidebarWidgetStyleSheet);
     int sidebarFontSize = 11;
 
-    // Important!  For QListWidget (used in sidebar), set
-    // QListWidget { outline: none } for the style sheet to get rid of the
+    // Important!  For QListView (used in sidebar), set
+    // QListView { outline: none } for the style sheet to get rid of the
     // focus rectangle without losing keyboard focus capability.
+    // QListView is used as the selector rather than QListWidget so that the
+    // style also applies to the outline, which is a plain QListView.
     // Unfortunately, this property isn't in the Qt documentation, so
     // it's being documented here for posterity's sake.
     //
 
     stream
-            << "QListWidget { outline: none; border: 0; padding: 1; background-color: "
+            << "QListView { outline: none; border: 0; padding: 1; background-color: "
             << this->m_backgroundColor.name()
             << "; color: "
             << this->m_foregroundColor.name()
             << "; font-size: "
             << sidebarFontSize
-            << "pt; font-weight: normal } QListWidget::item { border: 0; padding: 1 0 1 0; margin: 0; background-color: "
+            << "pt; font-weight: normal } QListView::item { border: 0; padding: 1 0 1 0; margin: 0; background-color: "
             << this->m_backgroundColor.name()
             << "; color: "
             << this->m_foregroundColor.name()
             << "; font-weight: normal } "
-            << "QListWidget::item:selected { border-radius: 0px; color: "
+            << "QListView::item:selected { border-radius: 0px; color: "
             << this->m_selectedFgColor.name()
             << "; background-color: "
             << this->m_selectedBgColor.name()
@@ -560,21 +570,8 @@ void StyleSheetBuilder::buildSidebarWidgetStyleSheet()
 
 void StyleSheetBuilder::buildHtmlPreviewCss(const bool roundedCorners) 
 {
-    if (m_htmlPreviewSass.isNull() || m_htmlPreviewSass.isEmpty())
-    {
-        QFile cssFile(":/resources/preview.css");
-
-        if (!cssFile.open(QIODevice::ReadOnly)) {
-            cssFile.close();
-            qWarning() << "Failed to load built-in HTML preview style sheet.";
-            return;
-        }
-
-        QTextStream inStream(&cssFile);
-        inStream.setCodec("UTF-8");
-        inStream.setAutoDetectUnicode(true);
-        m_htmlPreviewSass = inStream.readAll();
-        cssFile.close();
+    if (!loadHtmlPreviewTemplate()) {
+        return;
     }
 
     QColor baseScrollColor = this->m_foregroundColor;
@@ -586,30 +583,213 @@ void StyleSheetBuilder::buildHtmlPreviewCss(const bool roundedCorners)
         scrollBarBorderRadius = "3px";
     }
 
-    m_htmlPreviewCss = m_htmlPreviewSass;    
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$textColor", m_foregroundColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$backgroundColor", m_backgroundColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$textFont", m_htmlPreviewTextFont.family().remove(QRegularExpression("\\[.*\\]")).trimmed());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$fontSize", QString("%1pt").arg(m_htmlPreviewTextFont.pointSize()));
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$headingColor", m_headingColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$faintColor", m_faintColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$blockBackground", m_faintColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$codeColor", m_codeColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$linkColor", m_linkColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$blockquoteColor", m_blockquoteColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$thickBorderColor", m_thickBorderColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$scrollBarThumbColor", 
-        QString("rgba(%1, %2, %3, %4)")
+    QString scrollBarColor = QString("rgba(%1, %2, %3, %4)")
         .arg(baseScrollColor.red()).arg(baseScrollColor.green()).arg(baseScrollColor.blue())
-        .arg(baseScrollColor.alphaF()));
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$scrollBarThumbHoverColor", m_accentColor.name());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$scrollBarTrackColor",
-        QString("rgba(%1, %2, %3, %4)")
-        .arg(baseScrollColor.red()).arg(baseScrollColor.green()).arg(baseScrollColor.blue())
-        .arg(baseScrollColor.alphaF()));
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$scrollBarBorderRadius", scrollBarBorderRadius);
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$monospaceFont", m_htmlPreviewCodeFont.family().remove(QRegularExpression("\\[.*\\]")).trimmed());
-    m_htmlPreviewCss = m_htmlPreviewCss.replace("$codeFontSize", QString("%1pt").arg(m_htmlPreviewCodeFont.pointSize()));
+        .arg(baseScrollColor.alphaF());
+
+    QVector<QString> values(CssTokenCount);
+
+    values[TextColorToken] = m_foregroundColor.name();
+    values[BackgroundColorToken] = m_backgroundColor.name();
+    values[TextFontToken] = cssFontFamily(m_htmlPreviewTextFont);
+    values[FontSizeToken] = QString("%1pt").arg(m_htmlPreviewTextFont.pointSize());
+    values[HeadingColorToken] = m_headingColor.name();
+    values[FaintColorToken] = m_faintColor.name();
+    values[BlockBackgroundToken] = m_faintColor.name();
+    values[CodeColorToken] = m_codeColor.name();
+    values[LinkColorToken] = m_linkColor.name();
+    values[BlockquoteColorToken] = m_blockquoteColor.name();
+    values[ThickBorderColorToken] = m_thickBorderColor.name();
+    values[ScrollBarThumbColorToken] = scrollBarColor;
+    values[ScrollBarThumbHoverColorToken] = m_accentColor.name();
+    values[ScrollBarTrackColorToken] = scrollBarColor;
+    values[ScrollBarBorderRadiusToken] = scrollBarBorderRadius;
+    values[MonospaceFontToken] = cssFontFamily(m_htmlPreviewCodeFont);
+    values[CodeFontSizeToken] = QString("%1pt").arg(m_htmlPreviewCodeFont.pointSize());
+
+    // Fill in the precompiled template in a single pass.
+    int length = 0;
+
+    foreach (const CssSegment &segment, m_htmlPreviewTemplate) {
+        length += (segment.token < 0) ? segment.text.length() : values[segment.token].length();
+    }
+
+    m_htmlPreviewCss = QString();
+    m_htmlPreviewCss.reserve(length);
+
+    foreach (const CssSegment &segment, m_htmlPreviewTemplate) {
+        if (segment.token < 0) {
+            m_htmlPreviewCss.append(segment.text);
+        } else {
+            m_htmlPreviewCss.append(values[segment.token]);
+        }
+    }
+}
+
+void StyleSheetBuilder::buildStatIndicatorArrowIcon()
+{
+    // The icon only depends on the interface text color, so reuse the one
+    // already written out for this color, if any.
+    //
+    QString colorName = this->m_interfaceTextColor.name(QColor::HexArgb);
+
+    m_statIndicatorArrowIconPath = m_statIndicatorArrowIconPaths.value(colorName);
+
+    if (!m_statIndicatorArrowIconPath.isEmpty() && QFile::exists(m_statIndicatorArrowIconPath)) {
+        return;
+    }
+
+    QVariantMap options;
+    options.insert("color", this->m_interfaceTextColor);
+    QIcon statIndicatorIcon = this->m_awesome->icon(style::stfas, fa::chevroncircleup, options);
+
+    QTemporaryFile tempIconFile(QDir::tempPath() + "/XXXXXX.png");
+    tempIconFile.setAutoRemove(false);
+
+    if (tempIconFile.open()) {
+        m_statIndicatorArrowIconPath = tempIconFile.fileName();
+        statIndicatorIcon.pixmap(16, 16).save(&tempIconFile, "PNG");
+        tempIconFile.close();
+        m_statIndicatorArrowIconPaths.insert(colorName, m_statIndicatorArrowIconPath);
+    }
+}
+
+bool StyleSheetBuilder::loadHtmlPreviewTemplate()
+{
+    if (!m_htmlPreviewTemplate.isEmpty()) {
+        return true;
+    }
+
+    QFile cssFile(":/resources/preview.css");
+
+    if (!cssFile.open(QIODevice::ReadOnly)) {
+        cssFile.close();
+        qWarning() << "Failed to load built-in HTML preview style sheet.";
+        return false;
+    }
+
+    QTextStream inStream(&cssFile);
+    inStream.setCodec("UTF-8");
+    inStream.setAutoDetectUnicode(true);
+    QString sass = inStream.readAll();
+    cssFile.close();
+
+    // Names must be in the same order as the CssToken enum.
+    static const char * const tokenNames[CssTokenCount] = {
+        "textColor",
+        "backgroundColor",
+        "textFont",
+        "fontSize",
+        "headingColor",
+        "faintColor",
+        "blockBackground",
+        "codeColor",
+        "linkColor",
+        "blockquoteColor",
+        "thickBorderColor",
+        "scrollBarThumbColor",
+        "scrollBarThumbHoverColor",
+        "scrollBarTrackColor",
+        "scrollBarBorderRadius",
+        "monospaceFont",
+        "codeFontSize"
+    };
+
+    QHash<QString, int> tokens;
+
+    for (int i = 0; i < CssTokenCount; i++) {
+        tokens.insert(QString::fromLatin1(tokenNames[i]), i);
+    }
+
+    // Split the template into literal text and $token placeholders.  Where
+    // a placeholder is followed by more letters, the longest known token
+    // name that prefixes them wins.
+    //
+    QString literal;
+    int i = 0;
+
+    while (i < sass.length()) {
+        if (QChar('$') != sass[i]) {
+            literal.append(sass[i]);
+            i++;
+            continue;
+        }
+
+        int end = i + 1;
+
+        while ((end < sass.length()) && sass[end].isLetter()) {
+            end++;
+        }
+
+        int token = -1;
+        int nameLength = end - i - 1;
+
+        for (; nameLength > 0; nameLength--) {
+            token = tokens.value(sass.mid(i + 1, nameLength), -1);
+
+            if (token >= 0) {
+                break;
+            }
+        }
+
+        if (token < 0) {
+            literal.append(sass[i]);
+            i++;
+            continue;
+        }
+
+        if (!literal.isEmpty()) {
+            m_htmlPreviewTemplate.append({literal, -1});
+            literal.clear();
+        }
+
+        m_htmlPreviewTemplate.append({QString(), token});
+        i += nameLength + 1;
+    }
+
+    if (!literal.isEmpty()) {
+        m_htmlPreviewTemplate.append({literal, -1});
+    }
+
+    return true;
+}
+
+QString StyleSheetBuilder::memoizationKey
+(
+    const ColorScheme &colors,
+    const bool roundedCorners,
+    const QFont &previewTextFont,
+    const QFont &previewCodeFont
+)
+{
+    QStringList fields;
+
+    fields << colors.background.name(QColor::HexArgb)
+        << colors.foreground.name(QColor::HexArgb)
+        << colors.link.name(QColor::HexArgb)
+        << colors.selection.name(QColor::HexArgb)
+        << colors.headingText.name(QColor::HexArgb)
+        << colors.codeText.name(QColor::HexArgb)
+        << colors.blockquoteText.name(QColor::HexArgb)
+        << colors.emphasisMarkup.name(QColor::HexArgb)
+        << QString::number(roundedCorners)
+        << previewTextFont.toString()
+        << previewCodeFont.toString();
+
+    return fields.join('|');
+}
+
+QString StyleSheetBuilder::cssFontFamily(const QFont &font)
+{
+    QString family = font.family();
+    int start = family.indexOf('[');
+    int end = family.lastIndexOf(']');
+
+    if ((start >= 0) && (end > start)) {
+        family.remove(start, end - start + 1);
+    }
+
+    return family.trimmed();
 }
 
 // Algorithm taken from *Grokking the GIMP* by Carey Bunks,
@@ -20,8 +20,11 @@
 #ifndef STYLESHEETBUILDER_H
 #define STYLESHEETBUILDER_H
 
+#include <QCache>
 #include <QFont>
+#include <QHash>
 #include <QString>
+#include <QVector>
 
 #include "3rdparty/QtAwesome/QtAwesome.h"
 #include "colorscheme.h"
@@ -30,13 +33,16 @@ namespace ghostwriter
 {
 /**
  * A convenience class to generate widget stylesheets for the application
- * based on the provided color scheme.
+ * based on the provided color scheme.  Built style sheets are memoized, so
+ * that constructing a builder with the same colors, fonts, and corner style
+ * as a recent one does not rebuild them.
  */
 class StyleSheetBuilder
 {
 public:
     /**
-     * Constructor.
+     * Constructor.  Builds the style sheets, or fetches them from the
+     * memoized results of a previous builder with the same parameters.
      */
     StyleSheetBuilder(const ColorScheme &colors,
         const bool roundedCorners,
@@ -117,7 +123,43 @@ public:
     QColor faintColor();
 
 private:
-    static QString m_statIndicatorArrowIconPath;
+    /*
+     * Piece of the precompiled HTML preview style sheet template.  A
+     * segment is either literal text (token < 0) or a $token placeholder.
+     */
+    struct CssSegment
+    {
+        QString text;
+        int token;
+    };
+
+    enum CssToken
+    {
+        TextColorToken,
+        BackgroundColorToken,
+        TextFontToken,
+        FontSizeToken,
+        HeadingColorToken,
+        FaintColorToken,
+        BlockBackgroundToken,
+        CodeColorToken,
+        LinkColorToken,
+        BlockquoteColorToken,
+        ThickBorderColorToken,
+        ScrollBarThumbColorToken,
+        ScrollBarThumbHoverColorToken,
+        ScrollBarTrackColorToken,
+        ScrollBarBorderRadiusToken,
+        MonospaceFontToken,
+        CodeFontSizeToken,
+        CssTokenCount
+    };
+
+    static QHash<QString, QString> m_statIndicatorArrowIconPaths;
+    static QCache<QString, StyleSheetBuilder> m_memoizedBuilders;
+    static QVector<CssSegment> m_htmlPreviewTemplate;
+
+    QString m_statIndicatorArrowIconPath;
 
     QtAwesome *m_awesome;
     QColor m_backgroundColor;
@@ -147,7 +189,6 @@ private:
     QString m_findReplaceStyleSheet;
     QString m_sidebarStyleSheet;
     QString m_sidebarWidgetStyleSheet;
-    static QString m_htmlPreviewSass;
     QString m_htmlPreviewCss;
     QFont m_htmlPreviewTextFont;
     QFont m_htmlPreviewCodeFont;
@@ -163,6 +204,31 @@ private:
     void buildSidebarStyleSheet();
     void buildSidebarWidgetStyleSheet();
     void buildHtmlPreviewCss(const bool roundedCorners);
+    void buildStatIndicatorArrowIcon();
+
+    /*
+     * Loads and tokenizes the HTML preview style sheet template, if it has
+     * not been loaded already.  Returns false if it cannot be loaded.
+     */
+    static bool loadHtmlPreviewTemplate();
+
+    /*
+     * Returns the key under which style sheets built with the given
+     * parameters are memoized.
+     */
+    static QString memoizationKey
+    (
+        const ColorScheme &colors,
+        const bool roundedCorners,
+        const QFont &previewTextFont,
+        const QFont &previewCodeFont
+    );
+
+    /*
+     * Returns the font family name for use in CSS, without any foundry
+     * name in square brackets.
+     */
+    static QString cssFontFamily(const QFont &font);
 
     /**
      * Returns the luminance of this color on a scale of 0.0 (dark) to
@@ -0,0 +1,272 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+
+#include "taskscheduler.h"
+
+namespace ghostwriter
+{
+/*
+ * A job registered with the scheduler.
+ */
+struct ScheduledJob
+{
+    TaskScheduler::Priority priority;
+    TaskScheduler::Step step;
+    bool scheduled;
+};
+
+class TaskSchedulerPrivate
+{
+    Q_DECLARE_PUBLIC(TaskScheduler)
+
+public:
+    TaskSchedulerPrivate(TaskScheduler *q_ptr)
+        : q_ptr(q_ptr)
+    {
+        ;
+    }
+
+    ~TaskSchedulerPrivate()
+    {
+        ;
+    }
+
+    static const int PRIORITY_COUNT = TaskScheduler::HiddenPriority + 1;
+
+    TaskScheduler *q_ptr;
+    QHash<int, ScheduledJob> jobs;
+    QList<int> queues[PRIORITY_COUNT];
+    int nextJobId;
+    int frameBudget;
+    QTimer *dispatchTimer;
+    QElapsedTimer sliceTimer;
+    bool dispatching;
+
+    /*
+    * Runs scheduled jobs until they are all done or the time budget
+    * for the slice runs out.
+    */
+    void dispatch();
+
+    /*
+    * Removes and returns the ID of the highest priority scheduled job,
+    * or -1 if no jobs are scheduled.
+    */
+    int takeNextJob();
+
+    /*
+    * Queues the given job to run after the other jobs with its priority.
+    */
+    void enqueue(int id, ScheduledJob &job);
+};
+
+const int TaskScheduler::DEFAULT_FRAME_BUDGET_MS = 4;
+
+TaskScheduler *TaskScheduler::instance()
+{
+    static TaskScheduler *scheduler = new TaskScheduler();
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler()
+    : QObject(nullptr), d_ptr(new TaskSchedulerPrivate(this))
+{
+    Q_D(TaskScheduler);
+
+    d->nextJobId = 1;
+    d->frameBudget = DEFAULT_FRAME_BUDGET_MS;
+    d->dispatching = false;
+
+    d->dispatchTimer = new QTimer(this);
+    d->dispatchTimer->setSingleShot(true);
+    d->dispatchTimer->setInterval(0);
+
+    this->connect
+    (
+        d->dispatchTimer,
+        &QTimer::timeout,
+        [d]() {
+            d->dispatch();
+        }
+    );
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    ;
+}
+
+int TaskScheduler::addJob(QObject *owner, Priority priority, const Step &step)
+{
+    Q_D(TaskScheduler);
+
+    int id = d->nextJobId++;
+    d->jobs.insert(id, {priority, step, false});
+
+    this->connect
+    (
+        owner,
+        &QObject::destroyed,
+        this,
+        [this, id]() {
+            removeJob(id);
+        }
+    );
+
+    return id;
+}
+
+void TaskScheduler::removeJob(int job)
+{
+    Q_D(TaskScheduler);
+
+    cancel(job);
+    d->jobs.remove(job);
+}
+
+void TaskScheduler::schedule(int job)
+{
+    Q_D(TaskScheduler);
+
+    QHash<int, ScheduledJob>::iterator it = d->jobs.find(job);
+
+    if ((d->jobs.end() == it) || it->scheduled) {
+        return;
+    }
+
+    d->enqueue(job, *it);
+
+    if (!d->dispatching && !d->dispatchTimer->isActive()) {
+        d->dispatchTimer->start();
+    }
+}
+
+void TaskScheduler::cancel(int job)
+{
+    Q_D(TaskScheduler);
+
+    QHash<int, ScheduledJob>::iterator it = d->jobs.find(job);
+
+    if ((d->jobs.end() == it) || !it->scheduled) {
+        return;
+    }
+
+    d->queues[it->priority].removeOne(job);
+    it->scheduled = false;
+}
+
+bool TaskScheduler::isScheduled(int job) const
+{
+    Q_D(const TaskScheduler);
+
+    return d->jobs.value(job, {HiddenPriority, Step(), false}).scheduled;
+}
+
+void TaskScheduler::setPriority(int job, Priority priority)
+{
+    Q_D(TaskScheduler);
+
+    QHash<int, ScheduledJob>::iterator it = d->jobs.find(job);
+
+    if ((d->jobs.end() == it) || (priority == it->priority)) {
+        return;
+    }
+
+    if (it->scheduled) {
+        d->queues[it->priority].removeOne(job);
+        d->queues[priority].append(job);
+    }
+
+    it->priority = priority;
+}
+
+bool TaskScheduler::shouldYield() const
+{
+    Q_D(const TaskScheduler);
+
+    return d->dispatching && d->sliceTimer.hasExpired(d->frameBudget);
+}
+
+void TaskScheduler::setFrameBudget(int milliseconds)
+{
+    Q_D(TaskScheduler);
+
+    d->frameBudget = qMax(1, milliseconds);
+}
+
+void TaskSchedulerPrivate::dispatch()
+{
+    dispatching = true;
+    sliceTimer.start();
+
+    do {
+        int id = takeNextJob();
+
+        if (id < 0) {
+            break;
+        }
+
+        // Copy the step, since the job may unregister itself while running.
+        TaskScheduler::Step step = jobs.value(id).step;
+        bool done = step();
+
+        QHash<int, ScheduledJob>::iterator it = jobs.find(id);
+
+        // Requeue jobs that yielded, unless they were rescheduled or
+        // removed while running.
+        //
+        if (!done && (jobs.end() != it) && !it->scheduled) {
+            enqueue(id, *it);
+        }
+    } while (!sliceTimer.hasExpired(frameBudget));
+
+    dispatching = false;
+
+    for (int i = 0; i < PRIORITY_COUNT; i++) {
+        if (!queues[i].isEmpty()) {
+            dispatchTimer->start();
+            break;
+        }
+    }
+}
+
+int TaskSchedulerPrivate::takeNextJob()
+{
+    for (int i = 0; i < PRIORITY_COUNT; i++) {
+        if (!queues[i].isEmpty()) {
+            int id = queues[i].takeFirst();
+            jobs[id].scheduled = false;
+            return id;
+        }
+    }
+
+    return -1;
+}
+
+void TaskSchedulerPrivate::enqueue(int id, ScheduledJob &job)
+{
+    job.scheduled = true;
+    queues[job.priority].append(id);
+}
+} // namespace ghostwriter
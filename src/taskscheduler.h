@@ -0,0 +1,136 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <functional>
+
+#include <QObject>
+#include <QScopedPointer>
+
+namespace ghostwriter
+{
+/**
+ * Cooperative scheduler for deferred work on the GUI thread, such as
+ * refreshing the outline, updating document statistics, or rendering the
+ * preview after the user types.
+ *
+ * Subsystems register jobs with the scheduler and then schedule them
+ * whenever they have work to do.  Scheduling an already scheduled job has
+ * no effect, so bursts of changes are coalesced into a single run.  Jobs
+ * are run from the event loop in slices limited to a per-frame time budget,
+ * highest priority first, so that input and paint events are never kept
+ * waiting for long.  A job may do its work incrementally by checking
+ * shouldYield() and returning before it is done, in which case it is run
+ * again in a later slice.  Jobs whose work does not touch GUI objects
+ * should hand it off to the global thread pool (e.g., with QtConcurrent)
+ * and return right away.
+ */
+class TaskSchedulerPrivate;
+class TaskScheduler : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(TaskScheduler)
+
+public:
+    /**
+     * Job priorities, in order of precedence.  Priorities reflect the
+     * visibility of the work's results to the user.
+     */
+    enum Priority {
+        ViewportPriority,   // Results shown in the editor or preview.
+        SidebarPriority,    // Results shown in the active sidebar tab.
+        HiddenPriority      // Results in hidden panels.
+    };
+
+    /**
+     * A job step.  Returns true when the job has finished its work, or
+     * false if it yielded and needs to be run again.
+     */
+    typedef std::function<bool()> Step;
+
+    /**
+     * Default time budget in milliseconds for each slice of jobs run
+     * from the event loop.
+     */
+    static const int DEFAULT_FRAME_BUDGET_MS;
+
+    /**
+     * Returns the single instance of this class.
+     */
+    static TaskScheduler *instance();
+
+    /**
+     * Destructor.
+     */
+    virtual ~TaskScheduler();
+
+    /**
+     * Registers a job with the given priority, returning its ID for use
+     * with the other methods of this class.  The job is unregistered
+     * automatically when the given owner is destroyed.
+     */
+    int addJob(QObject *owner, Priority priority, const Step &step);
+
+    /**
+     * Unregisters the job with the given ID.
+     */
+    void removeJob(int job);
+
+    /**
+     * Schedules the job with the given ID to run.
+     */
+    void schedule(int job);
+
+    /**
+     * Cancels the job with the given ID if it is scheduled.
+     */
+    void cancel(int job);
+
+    /**
+     * Returns true if the job with the given ID is scheduled to run.
+     */
+    bool isScheduled(int job) const;
+
+    /**
+     * Changes the priority of the job with the given ID.
+     */
+    void setPriority(int job, Priority priority);
+
+    /**
+     * Returns true if the time budget for the current slice has run out,
+     * in which case incremental jobs should return false at the next
+     * convenient point so that they can be resumed in a later slice.
+     */
+    bool shouldYield() const;
+
+    /**
+     * Sets the time budget in milliseconds for each slice of jobs.
+     */
+    void setFrameBudget(int milliseconds);
+
+private:
+    TaskScheduler();
+
+    QScopedPointer<TaskSchedulerPrivate> d_ptr;
+};
+} // namespace ghostwriter
+
+#endif // TASK_SCHEDULER_H
@@ -23,13 +23,15 @@
 #include <QObject>
 #include <QTextBlock>
 #include <QTextBlockUserData>
+#include <QVector>
 
 #include "markdowndocument.h"
 
 namespace ghostwriter
 {
 /**
- * User data for use with the MarkdownHighlighter and DocumentStatistics.
+ * User data for use with the MarkdownHighlighter, DocumentStatistics,
+ * and MarkdownEditor.
  */
 class TextBlockData : public QObject, public QTextBlockUserData
 {
@@ -46,6 +48,15 @@ public:
         alphaNumericCharacterCount = 0;
         sentenceCount = 0;
         lixLongWordCount = 0;
+        blank = true;
+        statisticsRevision = -1;
+        paintRevision = -1;
+        paintState = -1;
+        paintPreviousState = -1;
+        blockAreaType = 0;
+        blockAreaStartType = 0;
+        rightToLeft = false;
+        sentenceRevision = -1;
     }
 
     /**
@@ -63,6 +74,36 @@ public:
     int sentenceCount;
     int lixLongWordCount;
 
+    /**
+     * Whether the block contains only whitespace.
+     */
+    bool blank;
+
+    /**
+     * Block revision for which the above counts were computed.
+     */
+    int statisticsRevision;
+
+    /**
+     * Paint metadata cached by the MarkdownEditor.  The metadata is valid
+     * as long as the block's revision and state, as well as the previous
+     * block's state, still match the values recorded here.
+     */
+    int paintRevision;
+    int paintState;
+    int paintPreviousState;
+    int blockAreaType;
+    int blockAreaStartType;
+    bool rightToLeft;
+
+    /**
+     * Sentence boundaries within the block, cached by the MarkdownEditor
+     * for the sentence focus mode.  Valid while sentenceRevision matches
+     * the block's revision.
+     */
+    QVector<int> sentenceBoundaries;
+    int sentenceRevision;
+
     /**
      * Parent text block.  For use with fetching the block's document
      * position, which can shift as text is inserted and deleted.
@@ -0,0 +1,182 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include "textmatcher.h"
+
+namespace ghostwriter
+{
+TextMatcher::TextMatcher()
+    : sensitivity(Qt::CaseSensitive), wholeWordOnly(false)
+{
+    ;
+}
+
+TextMatcher::TextMatcher
+(
+    const QString &query,
+    bool matchCase,
+    bool wholeWord,
+    bool regularExpression
+) : searchQuery(query),
+    sensitivity(matchCase ? Qt::CaseSensitive : Qt::CaseInsensitive),
+    wholeWordOnly(wholeWord)
+{
+    if (regularExpression) {
+        expression.setPattern(query);
+
+        QRegularExpression::PatternOptions options = expression.patternOptions();
+        options.setFlag(QRegularExpression::CaseInsensitiveOption, !matchCase);
+        expression.setPatternOptions(options);
+
+        // Compile (and JIT compile, where supported) the pattern now rather
+        // than on first use.
+        expression.optimize();
+    }
+}
+
+TextMatcher::~TextMatcher()
+{
+    ;
+}
+
+QString TextMatcher::query() const
+{
+    return searchQuery;
+}
+
+bool TextMatcher::isCaseSensitive() const
+{
+    return Qt::CaseSensitive == sensitivity;
+}
+
+bool TextMatcher::isWholeWord() const
+{
+    return wholeWordOnly;
+}
+
+bool TextMatcher::isRegularExpression() const
+{
+    return !expression.pattern().isEmpty();
+}
+
+bool TextMatcher::isValid() const
+{
+    if (searchQuery.isEmpty()) {
+        return false;
+    }
+
+    return expression.pattern().isEmpty() || expression.isValid();
+}
+
+TextMatches TextMatcher::matches(const QString &line) const
+{
+    TextMatches matches;
+
+    if (searchQuery.isEmpty()) {
+        return matches;
+    }
+
+    // Match non-breaking spaces as ordinary spaces, as QTextDocument::find()
+    // does for Find Next.  The replacement is one character for one, so
+    // match offsets into the original line are unchanged.
+    QString text = line;
+    text.replace(QChar::Nbsp, QLatin1Char(' '));
+
+    if (!expression.pattern().isEmpty()) {
+        QRegularExpressionMatchIterator it = expression.globalMatch(text);
+
+        while (it.hasNext()) {
+            QRegularExpressionMatch match = it.next();
+
+            if ((match.capturedLength() > 0)
+                    && isWholeWord(text, match.capturedStart(), match.capturedLength())) {
+                matches.append({match.capturedStart(), match.capturedLength()});
+            }
+        }
+    } else {
+        int length = searchQuery.length();
+        int index = text.indexOf(searchQuery, 0, sensitivity);
+
+        while (index >= 0) {
+            if (isWholeWord(text, index, length)) {
+                matches.append({index, length});
+                index += length;
+            } else {
+                index++;
+            }
+
+            index = text.indexOf(searchQuery, index, sensitivity);
+        }
+    }
+
+    return matches;
+}
+
+int TextMatcher::replaceAll(QTextDocument *document, const QString &replacement) const
+{
+    // Find all matches in a single pass before modifying the document.
+    TextMatches allMatches;
+
+    for (QTextBlock block = document->begin(); block.isValid(); block = block.next()) {
+        foreach (TextMatch match, matches(block.text())) {
+            match.start += block.position();
+            allMatches.append(match);
+        }
+    }
+
+    // Replace the matches from last to first so that the positions of the
+    // remaining matches are unaffected.  Doing so within one edit block
+    // makes the replacement a single undo step, and the document emits
+    // only one change notification at the end instead of one per
+    // replacement.
+    if (!allMatches.isEmpty()) {
+        QTextCursor cursor(document);
+
+        cursor.beginEditBlock();
+
+        for (int i = allMatches.size() - 1; i >= 0; i--) {
+            const TextMatch &match = allMatches.at(i);
+
+            cursor.setPosition(match.start);
+            cursor.setPosition(match.start + match.length, QTextCursor::KeepAnchor);
+            cursor.insertText(replacement);
+        }
+
+        cursor.endEditBlock();
+    }
+
+    return allMatches.size();
+}
+
+bool TextMatcher::isWholeWord(const QString &line, int start, int length) const
+{
+    if (!wholeWordOnly) {
+        return true;
+    }
+
+    int end = start + length;
+
+    return ((0 == start) || !line.at(start - 1).isLetterOrNumber())
+        && ((line.length() == end) || !line.at(end).isLetterOrNumber());
+}
+} // namespace ghostwriter
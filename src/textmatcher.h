@@ -0,0 +1,124 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef TEXTMATCHER_H
+#define TEXTMATCHER_H
+
+#include <QRegularExpression>
+#include <QString>
+#include <QVector>
+
+class QTextDocument;
+
+namespace ghostwriter
+{
+/**
+ * A match of a search query within a line of text.
+ */
+struct TextMatch
+{
+    int start;
+    int length;
+};
+
+typedef QVector<TextMatch> TextMatches;
+
+/**
+ * Finds occurrences of a search query within single lines of text, honoring
+ * the match case, whole word, and regular expression options of the
+ * find/replace widget.  Copies of a matcher are cheap and may be used
+ * concurrently from different threads.
+ */
+class TextMatcher
+{
+public:
+    /**
+     * Constructor.  Creates a matcher with an empty query, which never
+     * matches.
+     */
+    TextMatcher();
+
+    /**
+     * Constructor.  If regularExpression is true, the query is compiled
+     * into a regular expression up front so that it can be reused for
+     * every line searched.
+     */
+    TextMatcher
+    (
+        const QString &query,
+        bool matchCase,
+        bool wholeWord,
+        bool regularExpression
+    );
+
+    /**
+     * Destructor.
+     */
+    ~TextMatcher();
+
+    /**
+     * Returns the search query.
+     */
+    QString query() const;
+
+    /**
+     * Returns true if the query is matched case sensitively.
+     */
+    bool isCaseSensitive() const;
+
+    /**
+     * Returns true if the query is matched as whole words only.
+     */
+    bool isWholeWord() const;
+
+    /**
+     * Returns true if the query is a regular expression.
+     */
+    bool isRegularExpression() const;
+
+    /**
+     * Returns true if the query is non-empty and, for regular expressions,
+     * if the pattern is valid.
+     */
+    bool isValid() const;
+
+    /**
+     * Returns the non-overlapping matches of the query in the given line
+     * of text, in order of appearance.
+     */
+    TextMatches matches(const QString &line) const;
+
+    /**
+     * Replaces every match of the query within the given document with
+     * the replacement text as a single undoable edit.  Returns the number
+     * of replacements made.
+     */
+    int replaceAll(QTextDocument *document, const QString &replacement) const;
+
+private:
+    QString searchQuery;
+    QRegularExpression expression;
+    Qt::CaseSensitivity sensitivity;
+    bool wholeWordOnly;
+
+    bool isWholeWord(const QString &line, int start, int length) const;
+};
+} // namespace ghostwriter
+
+#endif // TEXTMATCHER_H
@@ -153,68 +153,79 @@ Theme ThemeRepository::loadTheme(const QString &name, QString &err) const
     }
 
     if (d->customThemeNames.contains(name)) {
-        QString themeFilePath = d->themeDirectoryPath + QString("/") +
-                                name + ".json";
+        return loadThemeFile(name, themeFilePath(name), err);
+    } else {
+        err = tr("The specified theme is not available.  Try restarting the application.  "
+                 "If problem persists, please file a bug report.");
+    }
 
-        QFileInfo themeFileInfo(themeFilePath);
+    return theme;
+}
 
-        if (!themeFileInfo.exists() && !themeFileInfo.isFile()) {
-            err = tr("The specified theme does not exist in the file system: %1")
-                  .arg(themeFilePath);
-            return theme;
-        }
+Theme ThemeRepository::loadThemeFile
+(
+    const QString &name,
+    const QString &filePath,
+    QString &err
+) const
+{
+    Q_D(const ThemeRepository);
 
-        QFile themeFile(themeFilePath);
+    Theme theme = d->builtInThemes[0];
+    err = QString();
 
-        if (!themeFile.open(QIODevice::ReadOnly)) {
-            err = tr("Could not open theme file for reading: %1")
-                  .arg(themeFilePath);
-            return theme;
-        }
+    QFileInfo themeFileInfo(filePath);
 
-        QJsonDocument json = QJsonDocument::fromJson(themeFile.readAll());
+    if (!themeFileInfo.exists() && !themeFileInfo.isFile()) {
+        err = tr("The specified theme does not exist in the file system: %1")
+              .arg(filePath);
+        return theme;
+    }
 
-        themeFile.close();
+    QFile themeFile(filePath);
 
-        if (json.isNull() || !json.isObject() || json.isEmpty()) {
-            err = tr("Invalid theme format: %1")
-                  .arg(themeFilePath);
-            return d->builtInThemes[0];
-        }
+    if (!themeFile.open(QIODevice::ReadOnly)) {
+        err = tr("Could not open theme file for reading: %1")
+              .arg(filePath);
+        return theme;
+    }
 
-        QJsonObject themeObject = json.object();
-        QJsonValue lightColorsObj = themeObject.value("light");
-        QJsonValue darkColorsObj = themeObject.value("dark");
-        Theme theme;
+    QJsonDocument json = QJsonDocument::fromJson(themeFile.readAll());
 
-        if (d->isValidJsonObj(lightColorsObj) && d->isValidJsonObj(darkColorsObj)) {
-            ColorScheme lightColors;
-            ColorScheme darkColors;
-            bool valid = true;
+    themeFile.close();
 
-            valid &= d->loadColorsFromJsonObject(lightColorsObj.toObject(), lightColors);
-            valid &= d->loadColorsFromJsonObject(darkColorsObj.toObject(), darkColors);
+    if (json.isNull() || !json.isObject() || json.isEmpty()) {
+        err = tr("Invalid theme format: %1")
+              .arg(filePath);
+        return d->builtInThemes[0];
+    }
 
-            if (!valid) {
-                err = tr("Invalid or missing value(s) in %1").arg(themeFileInfo.completeBaseName());
-            }
+    QJsonObject themeObject = json.object();
+    QJsonValue lightColorsObj = themeObject.value("light");
+    QJsonValue darkColorsObj = themeObject.value("dark");
 
-            theme = Theme(name, lightColors, darkColors, false);
-        } else {
-            ColorScheme colors;
-            bool valid = d->loadColorsFromJsonObject(themeObject, colors);
+    if (d->isValidJsonObj(lightColorsObj) && d->isValidJsonObj(darkColorsObj)) {
+        ColorScheme lightColors;
+        ColorScheme darkColors;
+        bool valid = true;
 
-            if (!valid) {
-                err = tr("Invalid or missing value(s) in %1").arg(themeFileInfo.completeBaseName());
-            }
+        valid &= d->loadColorsFromJsonObject(lightColorsObj.toObject(), lightColors);
+        valid &= d->loadColorsFromJsonObject(darkColorsObj.toObject(), darkColors);
 
-            theme = Theme(name, colors);
+        if (!valid) {
+            err = tr("Invalid or missing value(s) in %1").arg(themeFileInfo.completeBaseName());
         }
 
-        return theme;
+        theme = Theme(name, lightColors, darkColors, false);
     } else {
-        err = tr("The specified theme is not available.  Try restarting the application.  "
-                 "If problem persists, please file a bug report.");
+        ColorScheme colors;
+        bool valid = d->loadColorsFromJsonObject(themeObject, colors);
+
+        if (!valid) {
+            err = tr("Invalid or missing value(s) in %1").arg(themeFileInfo.completeBaseName());
+        }
+
+        theme = Theme(name, colors);
     }
 
     return theme;
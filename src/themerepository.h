@@ -70,6 +70,20 @@ public:
      */
     Theme loadTheme(const QString &name, QString &err) const;
 
+    /**
+     * Returns the custom theme with the given name, read from the given
+     * theme file.  Errors are reported as for loadTheme().  Unlike
+     * loadTheme(), this does not consult the list of available themes,
+     * which changes as themes are saved and deleted, so it is safe to call
+     * from a background thread.
+     */
+    Theme loadThemeFile
+    (
+        const QString &name,
+        const QString &filePath,
+        QString &err
+    ) const;
+
     /**
      * Deletes the theme with the given name from the hard disk.  Note
      * that this operation results in an error for built-in themes.  If an
@@ -20,16 +20,25 @@
 #include <QCheckBox>
 #include <QColor>
 #include <QDialogButtonBox>
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
 #include <QGridLayout>
 #include <QIcon>
+#include <QImage>
 #include <QList>
 #include <QListWidget>
 #include <QListWidgetItem>
 #include <QMessageBox>
+#include <QPixmap>
 #include <QPushButton>
+#include <QSaveFile>
+#include <QSet>
 #include <QSize>
+#include <QStandardPaths>
 #include <QString>
 #include <QStringList>
+#include <QtConcurrent>
 
 #include "3rdparty/QtAwesome/QtAwesome.h"
 
@@ -44,6 +53,76 @@
 
 namespace ghostwriter
 {
+/*
+ * A theme loaded in the background, along with its thumbnail preview.
+ */
+struct ThemeThumbnail
+{
+    QString themeName;
+    QString error;
+    QImage image;
+
+    // Name of the thumbnail's file in the on-disk cache, if it is cached.
+    QString cacheFileName;
+};
+
+/*
+ * A theme whose thumbnail is to be produced in the background.  This is
+ * resolved on the GUI thread, so that the background tasks never consult
+ * the theme repository's list of themes while the dialog creates, renames
+ * or deletes themes.
+ */
+struct ThemeThumbnailSource
+{
+    QString themeName;
+
+    // Theme file of a custom theme, which is loaded in the background.
+    // Empty for built-in themes.
+    QString filePath;
+
+    // The already loaded theme, if filePath is empty.
+    Theme theme;
+};
+
+/*
+ * Functor for QtConcurrent that loads a theme and produces its thumbnail,
+ * reading it from the on-disk thumbnail cache when possible and rendering
+ * (then caching) it otherwise.  Cached thumbnails are keyed by the
+ * theme's colors rather than by its file path and modification time, so
+ * every theme file is still read and parsed each time the list is built;
+ * only the rendering is skipped.
+ */
+class ThemeThumbnailTask
+{
+public:
+    typedef ThemeThumbnail result_type;
+
+    ThemeThumbnailTask
+    (
+        bool darkModeEnabled,
+        int width,
+        int height,
+        qreal dpr,
+        const QString &cacheDirPath
+    ) : darkModeEnabled(darkModeEnabled),
+        width(width),
+        height(height),
+        dpr(dpr),
+        cacheDirPath(cacheDirPath)
+    {
+        ;
+    }
+
+    ThemeThumbnail operator()(const ThemeThumbnailSource &source) const;
+
+private:
+    bool darkModeEnabled;
+    int width;
+    int height;
+    qreal dpr;
+    QString cacheDirPath;
+};
+
 class ThemeSelectionDialogPrivate
 {
     Q_DECLARE_PUBLIC(ThemeSelectionDialog)
@@ -53,17 +132,29 @@ public:
         : q_ptr(q_ptr),
           currentTheme(ThemeRepository::instance()->defaultTheme())
     {
-        this->awesome = new QtAwesome(q_ptr);
-        this->awesome->initFontAwesome();
+        this->awesome = QtAwesome::instance();
     }
 
     ~ThemeSelectionDialogPrivate()
     {
-        ;
+        // Let any thumbnail still rendering finish before the dialog
+        // goes away.
+        thumbnailWatcher->cancel();
+        thumbnailWatcher->waitForFinished();
     }
 
     ThemeSelectionDialog *q_ptr;
     QtAwesome *awesome;
+    QFutureWatcher<ThemeThumbnail> *thumbnailWatcher;
+
+    // Folder of the on-disk thumbnail cache, or empty if there is none.
+    QString thumbnailCacheDirPath;
+
+    // Names of the themes whose thumbnails are still being produced.  A
+    // theme is removed once its thumbnail is shown, or when it is edited
+    // or deleted, after which its pending thumbnail would be stale.
+    //
+    QSet<QString> pendingThumbnails;
 
     bool darkModeEnabled;
     QListWidget *themeListWidget;
@@ -79,6 +170,14 @@ public:
     QStringList builtInThemes;
 
     void buildThemeList(const QString &currentThemeName = nullptr);
+    void applyThumbnail(const ThemeThumbnail &thumbnail);
+
+    /*
+    * Deletes the cached thumbnails not used by the theme list just built,
+    * such as those of edited themes, so that the cache does not grow
+    * without bound.
+    */
+    void pruneThumbnailCache();
     void loadSelectedTheme();
     void createNewTheme();
     void deleteTheme();
@@ -147,6 +246,37 @@ ThemeSelectionDialog::ThemeSelectionDialog
     d->currentThemeIsValid = true;
     d->currentThemeIsNew = false;
 
+    // Thumbnails are rendered in the background and filled in as each one
+    // becomes available, so that the dialog opens right away.
+    //
+    ColorSchemePreviewer::initialize();
+    d->thumbnailWatcher = new QFutureWatcher<ThemeThumbnail>(this);
+
+    this->connect
+    (
+        d->thumbnailWatcher,
+        &QFutureWatcher<ThemeThumbnail>::resultReadyAt,
+        [d](int index) {
+            d->applyThumbnail(d->thumbnailWatcher->resultAt(index));
+        }
+    );
+
+    this->connect
+    (
+        d->thumbnailWatcher,
+        &QFutureWatcher<ThemeThumbnail>::finished,
+        [d]() {
+            // Skip a finished notification left over from a list build
+            // that was cancelled, since its results are incomplete.
+            //
+            QFuture<ThemeThumbnail> future = d->thumbnailWatcher->future();
+
+            if (future.isFinished() && !future.isCanceled()) {
+                d->pruneThumbnailCache();
+            }
+        }
+    );
+
     d->buildThemeList(currentThemeName);
 
     QCheckBox *darkModeCheckbox = new QCheckBox("Preview in dark mode", this);
@@ -235,6 +365,10 @@ void ThemeSelectionDialogPrivate::buildThemeList(const QString &currentThemeName
     dpr = this->themeListWidget->devicePixelRatioF();
 #endif
 
+    // Drop thumbnails still pending from a previous build of the list.
+    this->thumbnailWatcher->cancel();
+    this->thumbnailWatcher->waitForFinished();
+
     QStringList availableThemes =
         ThemeRepository::instance()->availableThemes();
     QList<QListWidgetItem *> selected = this->themeListWidget->selectedItems();
@@ -245,53 +379,120 @@ void ThemeSelectionDialogPrivate::buildThemeList(const QString &currentThemeName
     }
 
     this->themeListWidget->clear();
+    this->pendingThumbnails.clear();
 
-    for (int i = 0; i < availableThemes.size(); i++) {
-        QString themeName = availableThemes[i];
-        QString err;
-        QIcon themeIcon;
-
-        Theme theme = ThemeRepository::instance()->loadTheme(themeName, err);
-
-        ColorScheme colors;
-
-        if (this->darkModeEnabled && theme.hasDarkColorScheme()) {
-            colors = theme.darkColorScheme();
-        } else {
-            colors = theme.lightColorScheme();
-        }
+    QList<ThemeThumbnailSource> thumbnailSources;
 
-        ColorSchemePreviewer previewer
-        (
-            colors,
-            theme.isReadOnly(),
-            (err.isNull() || err.isEmpty()),
-            GW_LIST_WIDGET_ICON_WIDTH,
-            GW_LIST_WIDGET_ICON_HEIGHT,
-            dpr
-        );
+    // Keep the layout stable while the real thumbnails are loading.
+    QPixmap placeholder(this->iconWidth, this->iconHeight);
+    placeholder.fill(Qt::transparent);
 
-        themeIcon = previewer.icon();
+    for (int i = 0; i < availableThemes.size(); i++) {
+        QString themeName = availableThemes[i];
 
         QListWidgetItem *item = new QListWidgetItem
         (
-            themeIcon,
+            QIcon(placeholder),
             themeName,
             this->themeListWidget
         );
 
-        if (!err.isNull() && !err.isEmpty()) {
-            item->setToolTip(err);
+        this->themeListWidget->insertItem(this->themeListWidget->count(), item);
+
+        ThemeThumbnailSource source;
+        source.themeName = themeName;
+        source.filePath = ThemeRepository::instance()->themeFilePath(themeName);
+
+        if (!QFileInfo::exists(source.filePath)) {
+            QString err;
+
+            source.filePath = QString();
+            source.theme = ThemeRepository::instance()->loadTheme(themeName, err);
         }
 
-        this->themeListWidget->insertItem(this->themeListWidget->count(), item);
+        thumbnailSources.append(source);
+        this->pendingThumbnails.insert(themeName);
 
         if (themeName == currentName) {
+            QString err;
+
             this->themeListWidget->setCurrentItem(item);
-            this->currentTheme = theme;
+            this->currentTheme = ThemeRepository::instance()->loadTheme(themeName, err);
             this->currentThemeIsValid = (err.isNull() || err.isEmpty());
         }
     }
+
+    QString cacheDirPath =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+
+    if (!cacheDirPath.isEmpty()) {
+        cacheDirPath += "/themes";
+
+        if (!QDir(cacheDirPath).mkpath(".")) {
+            cacheDirPath = QString();
+        }
+    }
+
+    this->thumbnailCacheDirPath = cacheDirPath;
+
+    this->thumbnailWatcher->setFuture
+    (
+        QtConcurrent::mapped
+        (
+            thumbnailSources,
+            ThemeThumbnailTask
+            (
+                this->darkModeEnabled,
+                GW_LIST_WIDGET_ICON_WIDTH,
+                GW_LIST_WIDGET_ICON_HEIGHT,
+                dpr,
+                cacheDirPath
+            )
+        )
+    );
+}
+
+void ThemeSelectionDialogPrivate::applyThumbnail(const ThemeThumbnail &thumbnail)
+{
+    QList<QListWidgetItem *> items =
+        this->themeListWidget->findItems(thumbnail.themeName, Qt::MatchExactly);
+
+    // The item may have been edited, renamed or deleted since the
+    // thumbnail was requested, in which case the thumbnail is no longer
+    // needed.
+    //
+    if (!this->pendingThumbnails.remove(thumbnail.themeName) || items.isEmpty()) {
+        return;
+    }
+
+    QListWidgetItem *item = items.first();
+
+    item->setIcon(QPixmap::fromImage(thumbnail.image));
+
+    if (!thumbnail.error.isNull() && !thumbnail.error.isEmpty()) {
+        item->setToolTip(thumbnail.error);
+    }
+}
+
+void ThemeSelectionDialogPrivate::pruneThumbnailCache()
+{
+    if (this->thumbnailCacheDirPath.isEmpty()) {
+        return;
+    }
+
+    QSet<QString> usedFileNames;
+
+    foreach (const ThemeThumbnail &thumbnail, this->thumbnailWatcher->future().results()) {
+        usedFileNames.insert(thumbnail.cacheFileName);
+    }
+
+    QDir cacheDir(this->thumbnailCacheDirPath);
+
+    foreach (const QString &fileName, cacheDir.entryList(QStringList("*.png"), QDir::Files)) {
+        if (!usedFileNames.contains(fileName)) {
+            cacheDir.remove(fileName);
+        }
+    }
 }
 
 void ThemeSelectionDialogPrivate::loadSelectedTheme()
@@ -430,6 +631,7 @@ void ThemeSelectionDialogPrivate::deleteTheme()
         QString err;
 
         ThemeRepository::instance()->deleteTheme(themeName, err);
+        this->pendingThumbnails.remove(themeName);
 
         if (!err.isNull()) {
             MessageBoxHelper::critical
@@ -507,6 +709,8 @@ void ThemeSelectionDialogPrivate::updateTheme(const Theme &theme)
         QListWidgetItem *item = selectedThemes[0];
 
         if (nullptr != item) {
+            this->pendingThumbnails.remove(currentTheme.name());
+
             if (theme.name() != currentTheme.name()) {
                 item->setText(theme.name());
             }
@@ -537,4 +741,78 @@ void ThemeSelectionDialogPrivate::updateTheme(const Theme &theme)
 
     currentThemeIsNew = false;
 }
+
+ThemeThumbnail ThemeThumbnailTask::operator()(const ThemeThumbnailSource &source) const
+{
+    ThemeThumbnail thumbnail;
+
+    thumbnail.themeName = source.themeName;
+
+    Theme theme = source.theme;
+
+    if (!source.filePath.isEmpty()) {
+        theme = ThemeRepository::instance()->loadThemeFile
+            (
+                source.themeName,
+                source.filePath,
+                thumbnail.error
+            );
+    }
+
+    ColorScheme colors;
+
+    if (darkModeEnabled && theme.hasDarkColorScheme()) {
+        colors = theme.darkColorScheme();
+    } else {
+        colors = theme.lightColorScheme();
+    }
+
+    bool valid = thumbnail.error.isNull() || thumbnail.error.isEmpty();
+
+    // Thumbnails are cached under a hash of everything that affects their
+    // look, so an edited theme simply misses the cache.
+    //
+    QString cacheFilePath;
+
+    if (!cacheDirPath.isEmpty()) {
+        QByteArray key = ColorSchemePreviewer::cacheKey
+            (
+                colors,
+                theme.isReadOnly(),
+                valid,
+                width,
+                height,
+                dpr
+            );
+
+        thumbnail.cacheFileName = QString::fromLatin1(key) + ".png";
+        cacheFilePath = cacheDirPath + "/" + thumbnail.cacheFileName;
+
+        if (thumbnail.image.load(cacheFilePath, "PNG")) {
+            thumbnail.image.setDevicePixelRatio(dpr);
+            return thumbnail;
+        }
+    }
+
+    thumbnail.image = ColorSchemePreviewer::renderImage
+        (
+            colors,
+            theme.isReadOnly(),
+            valid,
+            width,
+            height,
+            dpr
+        );
+
+    if (!cacheFilePath.isEmpty()) {
+        QSaveFile cacheFile(cacheFilePath);
+
+        if (cacheFile.open(QIODevice::WriteOnly) &&
+                thumbnail.image.save(&cacheFile, "PNG")) {
+            cacheFile.commit();
+        }
+    }
+
+    return thumbnail;
+}
 } // namespace ghostwriter
@@ -0,0 +1,201 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QVector>
+
+#include "trace.h"
+
+namespace ghostwriter
+{
+/*
+ * A complete ("X" phase) trace event.
+ */
+struct TraceEvent
+{
+    const char *name;
+    const char *category;
+    int threadId;
+    qint64 start;
+    qint64 duration;
+};
+
+class TracerPrivate
+{
+public:
+    TracerPrivate()
+    {
+        ;
+    }
+
+    ~TracerPrivate()
+    {
+        ;
+    }
+
+    // Keep memory use bounded if tracing is left on for a long session.
+    static const int MAX_EVENTS = 1000000;
+
+    QMutex mutex;
+    QElapsedTimer clock;
+    QVector<TraceEvent> events;
+    QString filePath;
+    bool eventsDropped;
+
+    /*
+    * Returns a small, stable ID for the calling thread.
+    */
+    static int currentThreadId();
+};
+
+std::atomic<bool> Tracer::enabled(false);
+
+Tracer *Tracer::instance()
+{
+    static Tracer tracer;
+    return &tracer;
+}
+
+Tracer::Tracer()
+    : d_ptr(new TracerPrivate())
+{
+    Q_D(Tracer);
+
+    d->eventsDropped = false;
+
+    // The clock is started only here, and never restarted, since probes
+    // read it without taking the mutex.
+    //
+    d->clock.start();
+}
+
+Tracer::~Tracer()
+{
+    ;
+}
+
+void Tracer::start(const QString &filePath)
+{
+    Q_D(Tracer);
+
+    QMutexLocker locker(&d->mutex);
+
+    d->filePath = filePath;
+    d->events.clear();
+    d->eventsDropped = false;
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+bool Tracer::stop()
+{
+    Q_D(Tracer);
+
+    if (!enabled.exchange(false)) {
+        return true;
+    }
+
+    QMutexLocker locker(&d->mutex);
+    QSaveFile file(d->filePath);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    qint64 pid = QCoreApplication::applicationPid();
+    QTextStream stream(&file);
+
+    stream.setCodec("UTF-8");
+    stream << "{\"traceEvents\":[";
+
+    for (int i = 0; i < d->events.size(); i++) {
+        const TraceEvent &event = d->events.at(i);
+
+        if (i > 0) {
+            stream << ",";
+        }
+
+        stream << "\n{\"name\":\"" << event.name
+               << "\",\"cat\":\"" << event.category
+               << "\",\"ph\":\"X\",\"ts\":" << event.start
+               << ",\"dur\":" << event.duration
+               << ",\"pid\":" << pid
+               << ",\"tid\":" << event.threadId
+               << "}";
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"";
+
+    if (d->eventsDropped) {
+        stream << ",\"otherData\":{\"note\":\"event limit reached\"}";
+    }
+
+    stream << "}\n";
+    stream.flush();
+
+    d->events.clear();
+    d->events.squeeze();
+
+    return file.commit();
+}
+
+qint64 Tracer::timestamp() const
+{
+    Q_D(const Tracer);
+
+    return d->clock.nsecsElapsed() / 1000;
+}
+
+void Tracer::addEvent
+(
+    const char *name,
+    const char *category,
+    qint64 start,
+    qint64 duration
+)
+{
+    Q_D(Tracer);
+
+    int threadId = TracerPrivate::currentThreadId();
+    QMutexLocker locker(&d->mutex);
+
+    if (!isEnabled()) {
+        return;
+    }
+
+    if (d->events.size() >= TracerPrivate::MAX_EVENTS) {
+        d->eventsDropped = true;
+        return;
+    }
+
+    d->events.append({name, category, threadId, start, duration});
+}
+
+int TracerPrivate::currentThreadId()
+{
+    static std::atomic<int> nextThreadId(1);
+    thread_local int threadId = nextThreadId++;
+
+    return threadId;
+}
+} // namespace ghostwriter
@@ -0,0 +1,148 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2022 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+
+#include <QScopedPointer>
+#include <QString>
+
+namespace ghostwriter
+{
+/**
+ * Records the duration of instrumented stages of the editing pipeline and
+ * writes them out in the Chrome trace event JSON format, which can be
+ * opened in Perfetto or chrome://tracing.
+ *
+ * Recording is off by default.  When off, each probe costs a single
+ * relaxed atomic load.  Probes are compiled out entirely when
+ * GW_DISABLE_TRACING is defined.  Use the GW_TRACE_SCOPE macro to
+ * instrument a block of code rather than this class directly.
+ */
+class TracerPrivate;
+class Tracer
+{
+    Q_DECLARE_PRIVATE(Tracer)
+
+public:
+    /**
+     * Returns the single instance of this class.
+     */
+    static Tracer *instance();
+
+    /**
+     * Destructor.
+     */
+    ~Tracer();
+
+    /**
+     * Returns true if events are being recorded.
+     */
+    static bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Starts recording events, to be written to the given file path
+     * once stop() is called.
+     */
+    void start(const QString &filePath);
+
+    /**
+     * Stops recording events and writes the recorded events to the file
+     * given to start().  Returns false if the file could not be written.
+     */
+    bool stop();
+
+    /**
+     * Returns the time elapsed since the tracer was created, in
+     * microseconds.  Thread safe.
+     */
+    qint64 timestamp() const;
+
+    /**
+     * Records an event with the given name and category that started at
+     * the given timestamp and lasted for the given duration, on the
+     * calling thread.  The name and category must be string literals
+     * (or otherwise outlive the tracer).  Thread safe.
+     */
+    void addEvent
+    (
+        const char *name,
+        const char *category,
+        qint64 start,
+        qint64 duration
+    );
+
+private:
+    static std::atomic<bool> enabled;
+
+    Tracer();
+
+    QScopedPointer<TracerPrivate> d_ptr;
+};
+
+/**
+ * Records the time spent between its construction and destruction as a
+ * trace event, if tracing was enabled when it was constructed.
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char *name, const char *category)
+        : name(name), category(category), start(-1)
+    {
+        if (Tracer::isEnabled()) {
+            start = Tracer::instance()->timestamp();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (start >= 0) {
+            Tracer *tracer = Tracer::instance();
+            tracer->addEvent(name, category, start, tracer->timestamp() - start);
+        }
+    }
+
+private:
+    const char *name;
+    const char *category;
+    qint64 start;
+};
+} // namespace ghostwriter
+
+#ifdef GW_DISABLE_TRACING
+#define GW_TRACE_SCOPE(name, category)
+#else
+#define GW_TRACE_CONCAT_IMPL(a, b) a##b
+#define GW_TRACE_CONCAT(a, b) GW_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * Records the time spent in the enclosing scope under the given name and
+ * category, which must be string literals.
+ */
+#define GW_TRACE_SCOPE(name, category) \
+    ghostwriter::TraceScope GW_TRACE_CONCAT(gwTraceScope, __LINE__)(name, category)
+#endif
+
+#endif // TRACE_H